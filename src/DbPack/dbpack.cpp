@@ -0,0 +1,81 @@
+/*=============================================================================
+
+dbpack.cpp
+Packs the EOS and spectral data of a text Database into one binary file.
+
+Usage: ./festr_dbpack <Database_path> [packed_file_name]
+Input:  <Database_path>/grids/, <Database_path>/eos/, <Database_path>/spectra/
+Output: <Database_path>/dbase.fdb, or [packed_file_name] if given
+
+Note:
+Materials are the subdirectories of eos/ and spectra/. Every
+(material, te, tr, ne) point of the grids is probed; points without a zb.txt
+file or an em/ab/sc.txt triple are left out of the index. The packed file is
+selected in the FESTR options file with "Database_format: packed" following
+the "Database:" entry; the grids/ directory is still read as text.
+
+Peter Hakel
+Los Alamos National Laboratory
+XCP-5 group
+
+Created on 16 October 2026
+Last modified on 16 October 2026
+
+Copyright (c) 2015, Triad National Security, LLC.
+All rights reserved.
+Use of this source code is governed by the BSD 3-Clause License.
+See top-level license.txt file for full license text.
+
+CODE NAME:  FESTR, Version 0.9 (C15068)
+Classification Review Number: LA-CC-15-045
+Export Control Classification Number (ECCN): EAR99
+B&R Code:  DP1516090
+
+=============================================================================*/
+
+#include <Database.h>
+#include <DbPack.h>
+#include <constants.h>
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+
+const std::string main_name =
+    "./festr_dbpack <Database_path> [packed_file_name]";
+
+//-----------------------------------------------------------------------------
+
+void print_usage()
+{
+    std::cout << "Usage: " << main_name << std::endl;
+}
+
+//-----------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+    if (argc != 2  &&  argc != 3)
+    {
+        print_usage();
+        exit(EXIT_FAILURE);
+    }
+
+    std::string path(argv[1]);
+    if (path.back() != '/') path += "/";
+    std::string fname(argc == 3 ? argv[2] : path + cnststr::DBPACK_FNAME);
+
+    Database d("none", path, false);
+    size_t n = d.write_pack(fname);
+
+    DbPack p(fname);
+    std::cout << "Packed " << n << " records of " << p.get_nmat()
+              << " materials (nhv = " << p.get_nhv() << ") into " << fname
+              << std::endl;
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+//  end dbpack.cpp
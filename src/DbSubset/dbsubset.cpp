@@ -0,0 +1,159 @@
+/*=============================================================================
+
+dbsubset.cpp
+Writes the part of a text Database that one FESTR run needs.
+
+Usage: ./festr_dbsubset <options_file> <subset_Database_path> [packed]
+Input:  FESTR options file; the Database, Hydro, material Table and
+        Diagnostics that it names
+Output: <subset_Database_path>/grids/, eos/, spectra/, and with "packed"
+        also <subset_Database_path>/dbase.fdb
+
+Note:
+The materials and the te, tr, ne Database points are those found for all
+Zones at all time steps within tmin_tmax, exactly as in the postprocessing
+run; the hv range is the union of the Detector hv ranges. The te and tr
+grids are cut to the ranges in use, EOS files keep the full ne grid (the
+charge-neutrality search scans it), and spectra are cut to the ne and hv
+ranges in use. Detectors select their hv points by energy, and nearest-point
+lookups land on the same te, tr, ne values, so the run gives the same output
+with "Database:" pointing at the subset. Analysis mode (Goal other than
+"none") varies the Zone states, and is not supported.
+
+Peter Hakel
+Los Alamos National Laboratory
+XCP-5 group
+
+Created on 16 October 2026
+Last modified on 16 October 2026
+
+Copyright (c) 2015, Triad National Security, LLC.
+All rights reserved.
+Use of this source code is governed by the BSD 3-Clause License.
+See top-level license.txt file for full license text.
+
+CODE NAME:  FESTR, Version 0.9 (C15068)
+Classification Review Number: LA-CC-15-045
+Export Control Classification Number (ECCN): EAR99
+B&R Code:  DP1516090
+
+=============================================================================*/
+
+#include <Database.h>
+#include <Diagnostics.h>
+#include <Hydro.h>
+#include <constants.h>
+#include <utils.h>
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+const std::string main_name =
+    "./festr_dbsubset <options_file> <subset_Database_path> [packed]";
+
+//-----------------------------------------------------------------------------
+
+void print_usage()
+{
+    std::cout << "Usage: " << main_name << std::endl;
+}
+
+//-----------------------------------------------------------------------------
+
+std::string read_entry(std::ifstream &options, const std::string &word)
+{
+    utils::find_word(options, word);
+    std::string s;
+    options >> s;
+    return s;
+}
+
+//-----------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+    if ((argc != 3  &&  argc != 4)  ||
+        (argc == 4  &&  std::string(argv[3]) != "packed"))
+    {
+        print_usage();
+        exit(EXIT_FAILURE);
+    }
+
+    std::ifstream options(argv[1]);
+    if (!options.is_open())
+    {
+        std::cerr << "Error: file " << argv[1] << " is not open "
+                  << "in festr_dbsubset::main" << std::endl;
+        print_usage();
+        exit(EXIT_FAILURE);
+    }
+    std::string dest(argv[2]);
+    if (dest.back() != '/') dest += "/";
+
+    // same entries, in the same order, as in festr_main.cpp
+    std::string top_path(read_entry(options, "Top_path:"));
+    if (read_entry(options, "Goal:") != "none")
+    {
+        std::cerr << "Error: analysis mode is not supported "
+                  << "in festr_dbsubset::main" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::string out_path(top_path + read_entry(options, "Output:"));
+    std::string table_path(top_path
+                           + read_entry(options, "Material_table_path:"));
+    std::string table_fname(read_entry(options, "Material_table_file_name:"));
+    std::string hydro_path(top_path + read_entry(options, "Hydro:"));
+    std::string tops_cmnd(read_entry(options, "TOPS_command:"));
+    std::string dbase_path(top_path + read_entry(options, "Database:"));
+    if (tops_cmnd != "none")
+    {
+        std::cerr << "Error: only text Databases (TOPS_command: none) are "
+                  << "supported in festr_dbsubset::main" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::string diag_path(top_path + read_entry(options, "Diagnostics:"));
+    double tmin, tmax;
+    utils::find_word(options, "tmin_tmax:");
+    options >> tmin >> tmax;
+    options.close();
+
+    Database d("none", dbase_path, false);
+    Diagnostics diag(0, diag_path, hydro_path, out_path, d);
+    Hydro h(false, hydro_path, table_path, table_fname,
+            diag.det.at(0).get_symmetry(), tmin, tmax);
+
+    DbSubset s(diag.subset(d, h));
+    if (s.empty())
+    {
+        std::cerr << "Error: no Zone with materials in " << hydro_path
+                  << " in festr_dbsubset::main" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    size_t n = d.write_subset(dest, s);
+    std::cout << "Wrote " << n << " files of " << s.mat.size()
+              << " materials into " << dest
+              << "\nte index " << s.ite0 << " - " << s.ite1
+              << " of " << d.get_nte()
+              << "\ntr index " << s.itr0 << " - " << s.itr1
+              << " of " << d.get_ntr()
+              << "\nne index " << s.ine0 << " - " << s.ine1
+              << " of " << d.get_nne()
+              << "\nhv index " << s.jmin << " - " << s.jmax
+              << " of " << d.get_nhv() << std::endl;
+
+    if (argc == 4)
+    {
+        Database sub("none", dest, false);
+        std::string fname(dest + cnststr::DBPACK_FNAME);
+        std::cout << "Packed " << sub.write_pack(fname) << " records into "
+                  << fname << std::endl;
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+//  end dbsubset.cpp
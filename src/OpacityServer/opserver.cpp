@@ -0,0 +1,81 @@
+/*=============================================================================
+
+opserver.cpp
+Stand-in opacity server for TOPS_command: answers the batched requests of
+festr (see OpacityProvider) from a normal text or packed Database.
+
+Usage: ./festr_opserver <Database_path> [packed]
+Input:  batches of Zone states on standard input
+Output: mixed em, ab, sc spectra on standard output, one reply per batch
+
+Note:
+festr starts the server itself with the TOPS_command entry of its options
+file, which is read as a single word; a wrapper script containing, e.g.,
+exec /path/to/festr_opserver /path/to/Dbase/
+supplies the arguments. festr still reads the hv grid from its "Database:"
+path. The replies are computed exactly as festr does with
+TOPS_command: none, so both runs give the same output.
+Messages go to standard error; standard output carries the replies only.
+
+Peter Hakel
+Los Alamos National Laboratory
+XCP-5 group
+
+Created on 16 October 2026
+Last modified on 16 October 2026
+
+Copyright (c) 2015, Triad National Security, LLC.
+All rights reserved.
+Use of this source code is governed by the BSD 3-Clause License.
+See top-level license.txt file for full license text.
+
+CODE NAME:  FESTR, Version 0.9 (C15068)
+Classification Review Number: LA-CC-15-045
+Export Control Classification Number (ECCN): EAR99
+B&R Code:  DP1516090
+
+=============================================================================*/
+
+#include <Database.h>
+#include <OpacityProvider.h>
+#include <constants.h>
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+
+const std::string main_name = "./festr_opserver <Database_path> [packed]";
+
+//-----------------------------------------------------------------------------
+
+void print_usage()
+{
+    std::cerr << "Usage: " << main_name << std::endl;
+}
+
+//-----------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+    if ((argc != 2  &&  argc != 3)  ||
+        (argc == 3  &&  std::string(argv[2]) != "packed"))
+    {
+        print_usage();
+        exit(EXIT_FAILURE);
+    }
+    std::string dbase_path(argv[1]);
+    if (dbase_path.back() != '/') dbase_path += "/";
+    std::string dbase_pack("");
+    if (argc == 3) dbase_pack = dbase_path + cnststr::DBPACK_FNAME;
+
+    Database d("none", dbase_path, false, dbase_pack);
+    size_t n = OpacityProvider::serve(d, std::cin, std::cout);
+    std::cerr << "festr_opserver: " << n << " batches served from "
+              << dbase_path << "\n" << d.cache_to_string() << std::endl;
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+//  end opserver.cpp
@@ -0,0 +1,253 @@
+/*=============================================================================
+
+raybench.cpp
+Thread-scaling benchmark of Ray tracing through a hydro Mesh: rays/second
+vs. number of OpenMP threads, for the traversal through owning accessors
+(Mesh::get_zone, Zone::get_face, Surface::get_face: one shared_ptr copy,
+i.e., atomic reference count update, per call; Zone::hit) and for the
+traversal used by festr (Mesh::zone_at, Zone::face_at, Mesh::hit,
+Mesh::next_face: no reference counts touched).
+
+Usage: ./festr_raybench <Hydro_path> [time_label] [nrays] [max_threads]
+Defaults: time_label 0, nrays 100000, max_threads omp_get_max_threads()
+Rays start outside of the bounding Sphere and cross the Mesh along a fixed
+oblique direction, through a square array of starting points; only the
+geometry (Zone and Face crossings) is traced, no radiation transport.
+
+Peter Hakel
+Los Alamos National Laboratory
+XCP-5 group
+
+Created on 16 October 2026
+Last modified on 16 October 2026
+
+Copyright (c) 2015, Triad National Security, LLC.
+All rights reserved.
+Use of this source code is governed by the BSD 3-Clause License.
+See top-level license.txt file for full license text.
+
+CODE NAME:  FESTR, Version 0.9 (C15068)
+Classification Review Number: LA-CC-15-045
+Export Control Classification Number (ECCN): EAR99
+B&R Code:  DP1516090
+
+=============================================================================*/
+
+#include <constants.h>
+#include <Face.h>
+#include <Grid.h>
+#include <Mesh.h>
+#include <Sphere.h>
+#include <Surface.h>
+#include <Vector3d.h>
+#include <Zone.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+const std::string main_name =
+    "./festr_raybench <Hydro_path> [time_label] [nrays] [max_threads]";
+
+//-----------------------------------------------------------------------------
+
+void print_usage()
+{
+    std::cerr << "Usage: " << main_name << std::endl;
+}
+
+//-----------------------------------------------------------------------------
+
+double wall_time()
+{
+    #ifdef _OPENMP
+    return omp_get_wtime();
+    #else
+    return 0.0;
+    #endif
+}
+
+//-----------------------------------------------------------------------------
+
+/// Mesh::next_face through the owning accessors, without the portal table
+FaceID next_face_owning(const Grid &g, const Mesh &m, const RetIntercept &h)
+{
+    if (h.fid.my_id == -1)
+    {
+        auto z = m.get_zone(0);
+        auto f = z->get_face(1);
+        return f->get_neighbor(h.fid.my_zone);
+    }
+    auto z = m.get_zone(h.fid.my_zone);
+    auto f = z->get_face(h.fid.my_id);
+    size_t nf = f->num_nbr();
+    for (size_t i = 0; i < nf; ++i)
+    {
+        FaceID fid = f->get_neighbor(i);
+        if (fid.my_id == -1)
+        {
+            auto nz = m.get_zone(0);
+            FacePtr fz = nz->get_face(1);
+            SurfacePtr fs = std::dynamic_pointer_cast<Surface>(fz);
+            auto fn = fs->get_face(fid.my_zone);
+            if (fn->contains(g, h.w)) return FaceID(0, 1);
+        }
+        else
+        {
+            auto nz = m.get_zone(fid.my_zone);
+            auto fn = nz->get_face(fid.my_id);
+            if (fn->contains(g, h.w)) return fid;
+        }
+    }
+    return FaceID();
+}
+
+//-----------------------------------------------------------------------------
+
+/// Zone crossings of one Ray, as in Ray::trace; returns the number of Zones
+size_t trace(const Grid &g, const Mesh &m, Vector3d r, const Vector3d &v,
+             const bool owning)
+{
+    const size_t nmax = 10 * m.size() + 10; // guard against lost Rays
+    FaceID outface = Face::BOUNDING_SPHERE;
+    size_t zid = Zone::BOUNDING_ZONE;
+    size_t n = 0;
+    while (n < nmax)
+    {
+        ++n;
+        RetIntercept h;
+        if (owning)
+        {
+            auto z = m.get_zone(zid);
+            h = z->hit(g, r, v, outface);
+            outface = next_face_owning(g, m, h);
+        }
+        else
+        {
+            h = m.hit(g, zid, r, v, outface);
+            outface = m.next_face(g, h);
+        }
+        r = h.w;
+        if (h.fid == Face::BOUNDING_SPHERE) break;
+        zid = outface.my_zone;
+    }
+    return n;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Rays per second with nthreads threads; nz receives the Zone crossings
+double rays_per_second(const Grid &g, const Mesh &m,
+                       const std::vector<Vector3d> &r0, const Vector3d &v,
+                       const bool owning, const int nthreads, size_t &nz)
+{
+    const size_t nrays = r0.size();
+    size_t total = 0;
+    const double t0 = wall_time();
+    #ifdef _OPENMP
+    omp_set_num_threads(nthreads);
+    #pragma omp parallel for schedule(dynamic, 64) reduction(+:total)
+    #else
+    (void)(nthreads);
+    #endif
+    for (size_t i = 0; i < nrays; ++i)
+        total += trace(g, m, r0[i], v, owning);
+    const double dt = wall_time() - t0;
+    nz = total;
+    return dt > 0.0 ? static_cast<double>(nrays) / dt : 0.0;
+}
+
+//-----------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+    if (argc < 2  ||  argc > 5)
+    {
+        print_usage();
+        exit(EXIT_FAILURE);
+    }
+    std::string path(argv[1]);
+    if (path.back() != '/') path += "/";
+    const std::string tlabel(argc > 2 ? argv[2] : "0");
+    const size_t nrays = argc > 3 ? std::stoul(argv[3]) : 100000;
+    int max_threads = 1;
+    #ifdef _OPENMP
+    max_threads = omp_get_max_threads();
+    #endif
+    if (argc > 4) max_threads = std::stoi(argv[4]);
+    if (nrays == 0  ||  max_threads < 1)
+    {
+        print_usage();
+        exit(EXIT_FAILURE);
+    }
+
+    Grid g;
+    g.load(path, tlabel);
+    Mesh m(path, tlabel);
+    m.compile(g);
+
+    // Rays: square array of starting points in front of the bounding Sphere
+    auto s = std::dynamic_pointer_cast<Sphere>(
+        m.get_zone(Zone::BOUNDING_ZONE)->get_face(0));
+    if (!s)
+    {
+        std::cerr << "Error: no bounding Sphere in " << path << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    const Vector3d c = g.getr(s->get_node(0));
+    const double rs = fabs(s->getr());
+    Vector3d u(1.0, 0.31, 0.17);
+    u.normalize();
+    Vector3d e1 = u % Vector3d(0.0, 0.0, 1.0);
+    e1.normalize();
+    const Vector3d e2 = u % e1;
+    const size_t nside = static_cast<size_t>(ceil(sqrt(nrays)));
+    const double step = rs / static_cast<double>(nside);
+    std::vector<Vector3d> r0;
+    r0.reserve(nrays);
+    for (size_t i = 0; i < nrays; ++i)
+    {
+        const double a = (static_cast<double>(i % nside) + 0.5) * step;
+        const double b = (static_cast<double>(i / nside) + 0.5) * step;
+        r0.push_back(c - u * (2.0 * rs) + e1 * (a - 0.5*rs)
+                                        + e2 * (b - 0.5*rs));
+    }
+    const Vector3d v = u * cnst::CV;
+
+    std::cout << "festr_raybench: " << path << " time " << tlabel << ", "
+              << m.size() << " Zones, " << nrays << " Rays" << std::endl;
+    std::cout << "threads  owning(rays/s)  reference(rays/s)  speedup"
+              << std::endl;
+    std::vector<int> nthreads;
+    for (int nt = 1; nt < max_threads; nt *= 2) nthreads.push_back(nt);
+    nthreads.push_back(max_threads);
+    for (int nt : nthreads)
+    {
+        size_t nz_own = 0, nz_ref = 0;
+        const double own = rays_per_second(g, m, r0, v, true, nt, nz_own);
+        const double ref = rays_per_second(g, m, r0, v, false, nt, nz_ref);
+        std::cout << std::setw(7) << nt << std::setw(17) << std::fixed
+                  << std::setprecision(0) << own << std::setw(19) << ref
+                  << std::setw(9) << std::setprecision(2)
+                  << (own > 0.0 ? ref / own : 0.0) << std::endl;
+        if (nz_own != nz_ref)
+        {
+            std::cerr << "Error: Zone crossings differ (" << nz_own << " vs "
+                      << nz_ref << ")" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+//  end raybench.cpp
@@ -0,0 +1,69 @@
+#ifndef LANL_ASC_PEM_SPEC_EQT_H_
+#define LANL_ASC_PEM_SPEC_EQT_H_
+
+/*=============================================================================
+
+spec_eqt.h
+Comparison tolerances for spectral data (SpecReal), which are float in
+single-precision builds (-DSINGLE, makefile: single = yes).
+
+Peter Hakel
+Los Alamos National Laboratory
+XCP-5 group
+
+Created on 17 October 2026
+Last modified on 17 October 2026
+
+Copyright (c) 2015, Triad National Security, LLC.
+All rights reserved.
+Use of this source code is governed by the BSD 3-Clause License.
+See top-level license.txt file for full license text.
+
+CODE NAME:  FESTR, Version 0.9 (C15068)
+Classification Review Number: LA-CC-15-045
+Export Control Classification Number (ECCN): EAR99
+B&R Code:  DP1516090
+
+=============================================================================*/
+
+#include <ArrDbl.h>
+
+#include <algorithm>
+#include <cmath>
+
+//-----------------------------------------------------------------------------
+
+// Relative rounding of spectral results in single-precision builds
+
+const double SPEC_REL = 1.0e-6;
+
+//-----------------------------------------------------------------------------
+
+// Tolerance for a spectral value of size x: eqt in double builds; with
+// -DSINGLE, at least the float rounding of x
+
+inline double spec_eqt(const double eqt, const double x)
+{
+#ifdef SINGLE
+    return std::max(eqt, SPEC_REL * fabs(x));
+#else
+    static_cast<void>(x); // sets the scale in single builds only
+    return eqt;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+// As above, for the sum of absolute differences (ArrDbl::abs_diff) of
+// spectra x
+
+inline double spec_eqt(const double eqt, const ArrDbl &x)
+{
+    double s = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) s += fabs(x.at(i));
+    return spec_eqt(eqt, s);
+}
+
+//-----------------------------------------------------------------------------
+
+#endif  // LANL_ASC_PEM_SPEC_EQT_H_
@@ -0,0 +1,285 @@
+/*=============================================================================
+
+test_Block.cpp
+Definitions for unit, integration, and regression tests for class Block.
+
+Peter Hakel
+Los Alamos National Laboratory
+XCP-5 group
+
+Created on 16 October 2026
+Last modified on 16 October 2026
+
+Copyright (c) 2015, Triad National Security, LLC.
+All rights reserved.
+Use of this source code is governed by the BSD 3-Clause License.
+See top-level license.txt file for full license text.
+
+CODE NAME:  FESTR, Version 0.9 (C15068)
+Classification Review Number: LA-CC-15-045
+Export Control Classification Number (ECCN): EAR99
+B&R Code:  DP1516090
+
+=============================================================================*/
+
+//  Note: only use trimmed strings for names
+
+#include <test_Block.h>
+#include <Test.h>
+
+#include <constants.h>
+#include <Grid.h>
+#include <Mesh.h>
+#include <Ray.h>
+#include <utils.h>
+#include <Vector3d.h>
+#include <Zone.h>
+
+#include <cmath>
+
+void test_Block(int &failed_test_count, int &disabled_test_count)
+{
+const std::string GROUP = "Block";
+const double EQT = 1.0e-14;
+const std::string BLOCK1 = cnststr::PATH + "UniTest/Block1/";
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "default_size", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        Block b;
+        size_t expected = 0;
+        size_t actual = b.size();
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Mesh_load_sizes", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        Mesh m(BLOCK1, "0");
+        std::string expected = "5 4 4";
+        std::string actual = std::to_string(m.size()) + " "
+                           + std::to_string(m.get_block().size()) + " "
+                           + std::to_string(m.get_block().zone_id(1, 1, 0));
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Mesh_load_cell_materials", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        Mesh m(BLOCK1, "0");
+        Vector3d expected(3.0, 300.0, 400.0);
+        Vector3d actual(static_cast<double>(m.zone_at(3).get_id()),
+                        m.zone_at(3).get_te(), m.zone_at(4).get_te());
+
+        failed_test_count += t.check_equal_real_obj(expected, actual, EQT);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Mesh_clear", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        Mesh m(BLOCK1, "0");
+        m.clear();
+        size_t expected = 0;
+        size_t actual = m.get_block().size();
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "traverse_diagonal_zids", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        Mesh m(BLOCK1, "0");
+        Vector3d d(1.0, 0.4, 0.0);
+        ChordPath path;
+        m.get_block().traverse(Vector3d(-1.0, 0.0, 0.5), d/d.norm(), path);
+        std::string expected = "0 1 2 4 ";
+        std::string actual;
+        for (auto &c : path) actual += std::to_string(c.zid) + " ";
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "traverse_diagonal_chords", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        Mesh m(BLOCK1, "0");
+        Vector3d d(1.0, 0.4, 0.0);
+        ChordPath path;
+        m.get_block().traverse(Vector3d(-1.0, 0.0, 0.5), d/d.norm(), path);
+        const double s = sqrt(1.16); // chord per unit length along x
+        Vector3d expected(s, 0.5 * s, 0.5 * s);
+        Vector3d actual(path.at(1).ct, path.at(2).ct, path.at(3).ct);
+
+        failed_test_count += t.check_equal_real_obj(expected, actual, EQT);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "traverse_diagonal_exit", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        Mesh m(BLOCK1, "0");
+        Vector3d d(1.0, 0.4, 0.0);
+        ChordPath path;
+        double expected = 3.0 * sqrt(1.16);
+        double actual = m.get_block().traverse(Vector3d(-1.0, 0.0, 0.5),
+                                               d/d.norm(), path);
+
+        failed_test_count += t.check_equal_real_num(expected, actual, EQT);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "traverse_miss", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        Mesh m(BLOCK1, "0");
+        ChordPath path;
+        double r = m.get_block().traverse(Vector3d(-1.0, 5.0, 0.5),
+                                          Vector3d(1.0, 0.0, 0.0), path);
+        std::string expected = "0 0";
+        std::string actual = std::to_string(static_cast<int>(r)) + " "
+                           + std::to_string(path.size());
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Ray_trace_zids", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        Grid g(BLOCK1, "0");
+        Mesh m(BLOCK1, "0");
+        Vector3d r(1.0 - sqrt(24.75), 0.5, 0.5); // on the bounding Sphere
+        Vector3d v(2.0, 0.0, 0.0);
+        Ray ray(0, 0, 3, 0, 2, false, r, v, false, "", "");
+        ray.trace(g, m);
+        std::string expected = "0 1 2 0 ";
+        std::string actual;
+        for (auto &c : ray.path) actual += std::to_string(c.zid) + " ";
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Ray_trace_chord_sum", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        Grid g(BLOCK1, "0");
+        Mesh m(BLOCK1, "0");
+        Vector3d r(1.0 - sqrt(24.75), 0.5, 0.5);
+        Vector3d v(2.0, 0.0, 0.0);
+        Ray ray(0, 0, 3, 0, 2, false, r, v, false, "", "");
+        ray.trace(g, m);
+        double expected = 2.0 * sqrt(24.75);
+        double actual = 0.0;
+        for (auto &c : ray.path) actual += c.ct;
+
+        failed_test_count += t.check_equal_real_num(expected, actual, EQT);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Ray_trace_r", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        Grid g(BLOCK1, "0");
+        Mesh m(BLOCK1, "0");
+        Vector3d r(1.0 - sqrt(24.75), 0.5, 0.5);
+        Vector3d v(2.0, 0.0, 0.0);
+        Ray ray(0, 0, 3, 0, 2, false, r, v, false, "", "");
+        ray.trace(g, m);
+        Vector3d expected(1.0 + sqrt(24.75), 0.5, 0.5);
+        Vector3d actual(ray.r);
+
+        failed_test_count += t.check_equal_real_obj(expected, actual, EQT);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Ray_trace_miss", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        Grid g(BLOCK1, "0");
+        Mesh m(BLOCK1, "0");
+        Vector3d r(-3.0, 1.0, -2.5); // on the bounding Sphere, below Block
+        Vector3d v(1.0, 0.0, 0.0);
+        Ray ray(0, 0, 3, 0, 2, false, r, v, false, "", "");
+        ray.trace(g, m);
+        std::string expected = "1 0    8.000000e+00";
+        std::string actual = std::to_string(ray.path.size()) + " "
+                           + std::to_string(ray.path.at(0).zid) + " "
+                           + utils::double_to_string(ray.path.at(0).ct);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}
+
+//  end test_Block.cpp
@@ -0,0 +1,8 @@
+#ifndef LANL_ASC_PEM_TEST_BLOCK_H_
+#define LANL_ASC_PEM_TEST_BLOCK_H_
+
+#include <Block.h>
+
+void test_Block(int &, int &);
+
+#endif
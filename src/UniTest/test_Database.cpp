@@ -8,7 +8,7 @@ Los Alamos National Laboratory
 XCP-5 group
 
 Created on 31 December 2014
-Last modified on 2 October 2020
+Last modified on 17 October 2026
 
 Copyright (c) 2015, Triad National Security, LLC.
 All rights reserved.
@@ -26,6 +26,11 @@ B&R Code:  DP1516090
 
 #include <test_Database.h>
 #include <Test.h>
+#include <spec_eqt.h>
+
+#include <cstdio>
+#include <thread>
+#include <vector>
 
 void test_Database(int &failed_test_count, int &disabled_test_count)
 {
@@ -776,6 +781,652 @@ const double EQT = 1.0e-15;
 }
 
 //-----------------------------------------------------------------------------
+// Spectral cache
+//-----------------------------------------------------------------------------
+{
+    Test t(GROUP, "Dbase3_get_spectra_em", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        ArrDbl em, ab, sc;
+        d.get_spectra("z01", 0, 0, 5, 0, 2, em, ab, sc);
+        ArrDbl expected(3);
+        utils::load_array(path + "spectra/z01/z01_te06400ev_tr00000ev_ne5.0e16pcc_em.txt",
+                          3, 0, 2, expected);
+        ArrDbl actual(em);
+        const double eqt = spec_eqt(EQT, expected);
+
+        failed_test_count += t.check_equal_real_obj(expected, actual, eqt);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_get_spectra_sc_slice", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        ArrDbl em, ab, sc;
+        d.get_spectra("z18", 0, 0, 5, 0, 2, em, ab, sc);
+        d.get_spectra("z18", 0, 0, 5, 1, 2, em, ab, sc);
+        ArrDbl expected(2);
+        utils::load_array(path + "spectra/z18/z18_te06400ev_tr00000ev_ne5.0e16pcc_sc.txt",
+                          3, 1, 2, expected);
+        ArrDbl actual(sc);
+
+        failed_test_count += t.check_equal_real_obj(expected, actual, EQT);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_cache_hits", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        ArrDbl em, ab, sc;
+        d.get_spectra("z01", 0, 0, 5, 0, 2, em, ab, sc);
+        d.get_spectra("z01", 0, 0, 5, 1, 2, em, ab, sc);
+        d.get_spectra("z18", 0, 0, 5, 0, 1, em, ab, sc);
+        d.get_spectra("z01", 0, 0, 5, 0, 0, em, ab, sc);
+        size_t expected = 2;
+        size_t actual = d.get_cache_hits();
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_cache_misses", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        ArrDbl em, ab, sc;
+        d.get_spectra("z01", 0, 0, 5, 1, 2, em, ab, sc);
+        d.get_spectra("z01", 0, 0, 5, 0, 2, em, ab, sc); // widens the range
+        d.get_spectra("z01", 0, 0, 5, 0, 1, em, ab, sc);
+        d.get_spectra("z18", 0, 0, 5, 0, 2, em, ab, sc);
+        size_t expected = 3;
+        size_t actual = d.get_cache_misses();
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_cache_size", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        ArrDbl em, ab, sc;
+        d.get_spectra("z01", 0, 0, 5, 1, 2, em, ab, sc);
+        d.get_spectra("z01", 0, 0, 5, 0, 2, em, ab, sc);
+        d.get_spectra("z18", 0, 0, 5, 0, 2, em, ab, sc);
+        size_t expected = 2;
+        size_t actual = d.get_cache_size();
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_cache_evictions", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        const size_t b = 9 * sizeof(SpecReal); // 1 entry: 3 spectra * 3 hv
+        d.set_cache_budget(b);
+        ArrDbl em, ab, sc;
+        d.get_spectra("z01", 0, 0, 5, 0, 2, em, ab, sc);
+        d.get_spectra("z18", 0, 0, 5, 0, 2, em, ab, sc); // evicts z01
+        d.get_spectra("z01", 0, 0, 5, 0, 2, em, ab, sc); // evicts z18
+        std::string expected = "2 1 " + std::to_string(b);
+        std::string actual = std::to_string(d.get_cache_evictions()) + " "
+                           + std::to_string(d.get_cache_size()) + " "
+                           + std::to_string(d.get_cache_bytes());
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_cache_lru", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        const size_t b = 6 * sizeof(SpecReal); // two single-hv entries
+        d.set_cache_budget(b);
+        ArrDbl em, ab, sc;
+        d.get_spectra("z01", 0, 0, 5, 0, 0, em, ab, sc);
+        d.get_spectra("z18", 0, 0, 5, 0, 0, em, ab, sc);
+        d.get_spectra("z01", 0, 0, 5, 0, 0, em, ab, sc); // hit
+        d.get_spectra("z18", 0, 0, 5, 0, 0, em, ab, sc); // hit
+        d.get_spectra("z18", 0, 0, 5, 0, 1, em, ab, sc); // evicts z01
+        d.get_spectra("z18", 0, 0, 5, 1, 1, em, ab, sc); // hit
+        std::string expected = "3 3 1 " + std::to_string(b);
+        std::string actual = std::to_string(d.get_cache_hits()) + " "
+                           + std::to_string(d.get_cache_misses()) + " "
+                           + std::to_string(d.get_cache_evictions()) + " "
+                           + std::to_string(d.get_cache_bytes());
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_cache_concurrent_hits", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        ArrDbl em, ab, sc;
+        d.get_spectra("z01", 0, 0, 5, 0, 2, em, ab, sc); // the one miss
+        const size_t imat = d.material_index("z01");
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 4; ++i)
+            readers.emplace_back([&d, imat]()
+            {
+                ArrDbl x, y, z;
+                for (int k = 0; k < 1000; ++k)
+                    d.get_spectra(imat, 0, 0, 5, 0, 2, x, y, z);
+            });
+        for (auto &r : readers) r.join();
+        std::string expected = "4000 1 1";
+        std::string actual = std::to_string(d.get_cache_hits()) + " "
+                           + std::to_string(d.get_cache_misses()) + " "
+                           + std::to_string(d.get_cache_size());
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Preloaded zbar table
+//-----------------------------------------------------------------------------
+{
+    Test t(GROUP, "Dbase3_nzbar_mat", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        size_t expected = 2;
+        size_t actual = d.get_nzbar_mat();
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_zbar_row", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        std::string zfile(path + "eos/z18/z18_te06400ev_tr00000ev_ne3.0e16pcc_zb.txt");
+        std::ifstream infile(zfile.c_str());
+        utils::find_word(infile, "zbar");
+        double expected;
+        infile >> expected;
+        double actual = d.zbar_row("z18", 0, 0)[3];
+
+        failed_test_count += t.check_equal_real_num(expected, actual, EQT);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_StoichZbar_monotone", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <load_Table.inc>
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        std::vector<std::string> mat1 = {"d"};
+        std::vector<std::string> mat2 = {"d", "ar"}; // ar zbar row has a bump
+        std::vector<double> fp1 = {1.0};
+        std::vector<double> fp2 = {0.6, 0.4};
+        std::vector<size_t> mid1 = d.material_index(tbl, 1, mat1);
+        std::vector<size_t> mid2 = d.material_index(tbl, 2, mat2);
+        StoichZbar s1(&d, 0, 0, 1.0e16, 1, mid1, fp1);
+        StoichZbar s2(&d, 0, 0, 1.0e16, 2, mid2, fp2);
+        std::string expected = "true false";
+        std::string actual = utils::bool_to_string(s1.is_monotone()) + " "
+                           + utils::bool_to_string(s2.is_monotone());
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_ne_index_seeded", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <load_Table.inc>
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        std::vector<std::string> mat = {"d"};
+        std::vector<double> fp = {1.0};
+        std::string expected = "4 4 4";
+        std::string actual;
+        for (size_t hint : {0, 4, 7})
+        {
+            size_t ite(0), itr(0), ine(hint);
+            d.find_ne(tbl, 1000.0, ite, 1000.0, itr, 4.2e16, 1, mat, fp, ine);
+            actual += (actual.empty() ? "" : " ") + std::to_string(ine);
+        }
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_material_ids", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <load_Table.inc>
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        std::vector<std::string> mat = {"ar", "d"};
+        std::vector<double> fp = {0.4, 0.6};
+        std::vector<size_t> mid = d.material_index(tbl, 2, mat);
+        size_t ite(0), itr(0), ine(0), jte(0), jtr(0), jne(0);
+        NeData nd = d.find_ne(tbl, 1000.0, ite, 1000.0, itr, 4.2e16,
+                              2, mat, fp, ine);
+        double ne = d.find_ne(1000.0, jte, 1000.0, jtr, 4.2e16,
+                              2, mid, fp, jne);
+        std::string expected = "1 0 true";
+        std::string actual = std::to_string(mid.at(0)) + " "
+                           + std::to_string(mid.at(1)) + " "
+                           + utils::bool_to_string(ne == nd.first  &&
+                                                   jne == ine);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_mixture_key", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        MixKey k;
+        k.mid = {0, 1};
+        k.fp = {0.6, 0.4};
+        k.np = 1.0e20;
+        k.ite = k.itr = k.ine = 0;
+        k.jmin = 0;
+        k.jmax = 1;
+        ArrDbl em(2), ab(2), sc(2);
+        em[1] = 2.5;
+        d.put_mixture(k, em, ab, sc);
+        MixKey other(k);
+        other.fp = {0.4, 0.6};
+        ArrDbl x;
+        std::string expected = "true false";
+        std::string actual = utils::bool_to_string(d.get_mixture(k, x, x, x)
+                                                   &&  x.size() == 2)
+            + " " + utils::bool_to_string(d.get_mixture(other, x, x, x));
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_mixture_shares_budget", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        d.set_cache_budget(9 * sizeof(SpecReal)); // 1 entry: 3 arrays * 3 hv
+        ArrDbl em, ab, sc;
+        d.get_spectra("z01", 0, 0, 5, 0, 2, em, ab, sc);
+        MixKey k;
+        k.mid = {0};
+        k.fp = {1.0};
+        k.np = 1.0e20;
+        k.ite = k.itr = k.ine = 0;
+        k.jmin = 0;
+        k.jmax = 2;
+        d.put_mixture(k, em, ab, sc); // evicts the older spectral entry
+        std::string expected = "0 1 1";
+        std::string actual = std::to_string(d.get_cache_size()) + " "
+                           + std::to_string(d.get_mix_size()) + " "
+                           + std::to_string(d.get_cache_evictions());
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_mixture_lru", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        d.set_cache_budget(6 * sizeof(SpecReal)); // two single-hv mixtures
+        MixKey a;
+        a.mid = {0};
+        a.fp = {1.0};
+        a.np = 1.0e20;
+        a.ite = a.itr = a.ine = 0;
+        a.jmin = a.jmax = 0;
+        MixKey b(a), c(a);
+        b.np = 2.0e20;
+        c.np = 3.0e20;
+        ArrDbl em(1), ab(1), sc(1), x;
+        d.put_mixture(a, em, ab, sc);
+        d.put_mixture(b, em, ab, sc);
+        d.get_mixture(a, x, x, x);    // hit: b is now the oldest
+        d.put_mixture(c, em, ab, sc); // evicts b only
+        std::string expected = "true false true 2 1";
+        std::string actual = utils::bool_to_string(d.get_mixture(a, x, x, x))
+            + " " + utils::bool_to_string(d.get_mixture(b, x, x, x))
+            + " " + utils::bool_to_string(d.get_mixture(c, x, x, x))
+            + " " + std::to_string(d.get_mix_size())
+            + " " + std::to_string(d.get_cache_evictions());
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Band-averaged (multigroup) data
+//-----------------------------------------------------------------------------
+{
+    Test t(GROUP, "band_weights", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::vector<double> x = {300.0, 600.0, 900.0};
+        std::vector<double> w = Database::band_weights(x, 0, 2);
+        std::vector<double> w1 = Database::band_weights(x, 1, 1);
+        std::string expected = "   1.500000e+02   3.000000e+02   1.500000e+02"
+                               "   1.000000e+00";
+        std::string actual = utils::double_to_string(w.at(0))
+                           + utils::double_to_string(w.at(1))
+                           + utils::double_to_string(w.at(2))
+                           + utils::double_to_string(w1.at(0));
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_get_bands", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        BandSet b;
+        b.jlo = {0};
+        b.jhi = {2};
+        b.weight = "planck";
+        size_t ib = d.band_index(b);
+        BandSet r(b);
+        r.weight = "rosseland";
+        size_t ir = d.band_index(r);
+        ArrDbl em, ab, sc, vem, vab, vsc;
+        d.get_spectra(1, 0, 0, 5, 0, 2, vem, vab, vsc);
+        d.get_bands(1, 0, 0, 5, ib, em, ab, sc);
+        d.get_bands(1, 0, 0, 5, ib, em, ab, sc); // from the band cache
+        double emx = 0.25 * vem[0] + 0.5 * vem[1] + 0.25 * vem[2];
+        std::string expected = "0 1 0 1 true";
+        std::string actual = std::to_string(ib) + " " + std::to_string(ir)
+            + " " + std::to_string(d.band_index(b)) + " "
+            + std::to_string(d.get_band_size()) + " "
+            + utils::bool_to_string(std::abs(em[0] - emx) <= 1.0e-6 * emx);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_bands_share_budget", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        d.set_cache_budget(9 * sizeof(SpecReal)); // 1 entry: 3 arrays * 3 hv
+        BandSet b;
+        b.jlo = {0, 1};
+        b.jhi = {1, 2};
+        b.weight = "planck";
+        size_t ib = d.band_index(b);
+        ArrDbl em, ab, sc;
+        d.get_bands(1, 0, 0, 5, ib, em, ab, sc); // evicts its spectra
+        d.get_bands(1, 0, 0, 5, ib, em, ab, sc); // hit
+        std::string expected = "0 1 1 " + std::to_string(6 * sizeof(SpecReal));
+        std::string actual = std::to_string(d.get_cache_size()) + " "
+                           + std::to_string(d.get_band_size()) + " "
+                           + std::to_string(d.get_cache_evictions()) + " "
+                           + std::to_string(d.get_cache_bytes());
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Subset written for one run
+//-----------------------------------------------------------------------------
+{
+    Test t(GROUP, "Dbase3_write_subset", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        std::string dest(cnststr::PATH + "UniTest/Output/Dbase3sub/");
+        Database d("none", path, false);
+        DbSubset s;
+        s.add("z18", 0, 0, 5);
+        s.jmin = 1;
+        s.jmax = 2;
+        size_t n = d.write_subset(dest, s); // 8 zb, 3 spectra
+        Database sub("none", dest, false);
+        ArrDbl em, ab, sc;
+        sub.get_spectra("z18", 0, 0, 5, 0, 1, em, ab, sc);
+        std::string expected = "11 2 8   2.000000e+15   5.000000e+15";
+        std::string actual = std::to_string(n) + " "
+                           + std::to_string(sub.get_nhv()) + " "
+                           + std::to_string(sub.get_nne())
+                           + utils::double_to_string(em[0])
+                           + utils::double_to_string(em[1]);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Catalog of available data, checked before a run
+//-----------------------------------------------------------------------------
+{
+    Test t(GROUP, "Dbase3_has_spectra", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        std::string expected = "true false false";
+        std::string actual = utils::bool_to_string(d.has_spectra(1, 0, 0, 5))
+            + " " + utils::bool_to_string(d.has_spectra(1, 0, 0, 4))
+            + " " + utils::bool_to_string(d.has_spectra(2, 0, 0, 5));
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_check", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        std::set<SpecKey> keys = {SpecKey(0, 0, 0, 5), SpecKey(1, 0, 0, 4)};
+        std::ostringstream ost;
+        size_t n = d.check(keys, ost);
+        std::string expected = "1 Missing: spectra of z18 at te = 06400, "
+                               "tr = 00000, ne = 4.0e16\n";
+        std::string actual = std::to_string(n) + " " + ost.str();
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_catalog_index", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        std::string dest(cnststr::PATH + "UniTest/Output/Dbase3cat/");
+        Database d("none", path, false);
+        DbSubset s;
+        s.add("z01", 0, 0, 5);
+        s.add("z18", 0, 0, 5);
+        s.jmin = 0;
+        s.jmax = 2;
+        d.write_subset(dest, s);
+        Database scanned("none", dest, false);
+        scanned.scan(); // an index from an earlier test run may be present
+        size_t n = scanned.write_catalog(dest + cnststr::CATALOG_FNAME);
+        Database indexed("none", dest, false);
+        size_t ite(0), itr(0), ine(0), jte(0), jtr(0), jne(0);
+        std::vector<size_t> mid = {1};
+        std::vector<double> fp = {1.0};
+        double ne1 = scanned.find_ne(1000.0, ite, 1000.0, itr, 4.2e16,
+                                     1, mid, fp, ine);
+        double ne2 = indexed.find_ne(1000.0, jte, 1000.0, jtr, 4.2e16,
+                                     1, mid, fp, jne);
+        std::string expected = "16 true false true true";
+        std::string actual = std::to_string(n) + " "
+            + utils::bool_to_string(indexed.is_cataloged()) + " "
+            + utils::bool_to_string(scanned.is_cataloged()) + " "
+            + utils::bool_to_string(indexed.has_spectra(1, 0, 0, 5)) + " "
+            + utils::bool_to_string(ne1 == ne2  &&  ine == jne);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_catalog_stale", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        std::string dest(cnststr::PATH + "UniTest/Output/Dbase3stale/");
+        Database d("none", path, false);
+        DbSubset s;
+        s.add("z01", 0, 0, 5);
+        s.add("z18", 0, 0, 5);
+        s.jmin = 0;
+        s.jmax = 2;
+        d.write_subset(dest, s);
+        Database scanned("none", dest, false);
+        scanned.scan(); // an index from an earlier test run may be present
+        scanned.write_catalog(dest + cnststr::CATALOG_FNAME);
+        const std::string froot(dest + "spectra/z18/" + utils::fname_root(
+            "z18", d.get_te_str_at(0), d.get_tr_str_at(0),
+            d.get_ne_str_at(5)));
+        for (auto &q : {"em.txt", "ab.txt", "sc.txt"})
+            std::remove((froot + q).c_str());
+        Database indexed("none", dest, false);
+        std::string expected = "true false false";
+        std::string actual =
+            utils::bool_to_string(scanned.has_spectra(1, 0, 0, 5))
+            + " " + utils::bool_to_string(indexed.is_cataloged())
+            + " " + utils::bool_to_string(indexed.has_spectra(1, 0, 0, 5));
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
 
 }
 
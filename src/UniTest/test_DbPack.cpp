@@ -0,0 +1,295 @@
+/*=============================================================================
+
+test_DbPack.cpp
+Definitions for unit, integration, and regression tests for class DbPack.
+
+Peter Hakel
+Los Alamos National Laboratory
+XCP-5 group
+
+Created on 16 October 2026
+Last modified on 17 October 2026
+
+Copyright (c) 2015, Triad National Security, LLC.
+All rights reserved.
+Use of this source code is governed by the BSD 3-Clause License.
+See top-level license.txt file for full license text.
+
+CODE NAME:  FESTR, Version 0.9 (C15068)
+Classification Review Number: LA-CC-15-045
+Export Control Classification Number (ECCN): EAR99
+B&R Code:  DP1516090
+
+=============================================================================*/
+
+//  Note: only use trimmed strings for names
+
+#include <test_DbPack.h>
+#include <Test.h>
+
+#include <Database.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * Copies packed Database file fname without its last ncut bytes, and opens
+ * the copy as a DbPack in a child process
+ * @return Exit status of the child: EXIT_SUCCESS, if the copy was accepted
+ */
+static int open_truncated(const std::string &fname, const size_t ncut)
+{
+    std::ifstream infile(fname.c_str(), std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(infile)),
+                      std::istreambuf_iterator<char>());
+    infile.close();
+    std::string cut(fname + ".cut");
+    std::ofstream outfile(cut.c_str(), std::ios::binary);
+    outfile.write(bytes.data(),
+                  static_cast<std::streamsize>(bytes.size() - ncut));
+    outfile.close();
+
+    std::cout.flush();
+    std::cerr.flush();
+    pid_t pid = fork();
+    if (pid == 0) // child: the error message is expected, and not shown
+    {
+        if (freopen("/dev/null", "w", stderr) == nullptr) _exit(2);
+        DbPack p(cut);
+        _exit(EXIT_SUCCESS);
+    }
+    int status = -1;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+void test_DbPack(int &failed_test_count, int &disabled_test_count)
+{
+const std::string GROUP = "DbPack";
+const double EQT = 1.0e-15;
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_write_pack", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        Database d("none", path, false);
+        size_t expected = 16; // 8 zbars per material, spectra at one ne
+        size_t actual = d.write_pack(cnststr::PATH
+                                     + "UniTest/Output/Dbase3.fdb");
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_materials", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        std::string fname(cnststr::PATH + "UniTest/Output/Dbase3.fdb");
+        Database d("none", path, false);
+        d.write_pack(fname);
+        DbPack p(fname);
+        std::string expected = "z01 z18 2";
+        std::string actual = p.get_material(0) + " " + p.get_material(1)
+            + " " + std::to_string(p.find_material("z99"));
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_not_shared", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {   // node-level shared-memory window only after MPI_Init
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        std::string fname(cnststr::PATH + "UniTest/Output/Dbase3.fdb");
+        Database d("none", path, false);
+        d.write_pack(fname);
+        DbPack p(fname);
+        bool expected = false;
+        bool actual = p.is_shared();
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_zbar", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        std::string fname(cnststr::PATH + "UniTest/Output/Dbase3.fdb");
+        Database d("none", path, false);
+        d.write_pack(fname);
+        DbPack p(fname);
+        std::string zfile(path + "eos/z18/z18_te06400ev_tr00000ev_ne1.5e16pcc_zb.txt");
+        std::ifstream infile(zfile.c_str());
+        utils::find_word(infile, "zbar");
+        double expected;
+        infile >> expected;
+        double actual = *p.get_zbar(1, 0, 0, 1);
+
+        failed_test_count += t.check_equal_real_num(expected, actual, EQT);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_spectra_absent", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        std::string fname(cnststr::PATH + "UniTest/Output/Dbase3.fdb");
+        Database d("none", path, false);
+        d.write_pack(fname);
+        DbPack p(fname);
+        bool expected = true;
+        bool actual = (p.get_spectra(0, 0, 0, 4) == nullptr);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_packed_get_spectra_ab", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        std::string fname(cnststr::PATH + "UniTest/Output/Dbase3.fdb");
+        Database dt("none", path, false);
+        dt.write_pack(fname);
+        Database d("none", path, false, fname);
+        ArrDbl em, ab, sc;
+        dt.get_spectra("z18", 0, 0, 5, 1, 2, em, ab, sc);
+        ArrDbl expected(ab);
+        d.get_spectra("z18", 0, 0, 5, 1, 2, em, ab, sc);
+        ArrDbl actual(ab);
+
+        failed_test_count += t.check_equal_real_obj(expected, actual, EQT);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_packed_ne_value", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <load_Table.inc>
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        std::string fname(cnststr::PATH + "UniTest/Output/Dbase3.fdb");
+        Database dt("none", path, false);
+        dt.write_pack(fname);
+        Database d("none", path, false, fname);
+        std::vector<std::string> mat = {"d", "ar"};
+        std::vector<double> fp = {0.6, 0.4};
+        size_t ite(0), itr(0), ine(0);
+        NeData ne_pair(d.find_ne(tbl, 1000.0, ite, 1000.0, itr, 1.0e16,
+                                 2, mat, fp, ine));
+        double expected = 4.6e16;
+        double actual = ne_pair.first;
+
+        failed_test_count += t.check_equal_real_num(expected, actual, 1.0e5);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_truncated_data", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {   // last double of the data block missing
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        std::string fname(cnststr::PATH + "UniTest/Output/Dbase3.fdb");
+        Database d("none", path, false);
+        d.write_pack(fname);
+        int expected = EXIT_FAILURE;
+        int actual = open_truncated(fname, sizeof(double));
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_truncated_index", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {   // header, handles, and part of the index only
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        std::string fname(cnststr::PATH + "UniTest/Output/Dbase3.fdb");
+        Database d("none", path, false);
+        d.write_pack(fname);
+        std::ifstream infile(fname.c_str(), std::ios::binary | std::ios::ate);
+        size_t nbytes = static_cast<size_t>(infile.tellg());
+        infile.close();
+        const size_t nkeep = DbPack::MAGIC.size() + 6 * sizeof(uint64_t)
+                           + 2 * DbPack::HANDLE_SIZE + sizeof(DbPackEntry);
+        int expected = EXIT_FAILURE;
+        int actual = open_truncated(fname, nbytes - nkeep);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Dbase3_not_truncated", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        std::string fname(cnststr::PATH + "UniTest/Output/Dbase3.fdb");
+        Database d("none", path, false);
+        d.write_pack(fname);
+        int expected = EXIT_SUCCESS;
+        int actual = open_truncated(fname, 0);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}
+
+//  end test_DbPack.cpp
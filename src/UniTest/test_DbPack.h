@@ -0,0 +1,8 @@
+#ifndef LANL_ASC_PEM_TEST_DBPACK_H_
+#define LANL_ASC_PEM_TEST_DBPACK_H_
+
+#include <DbPack.h>
+
+void test_DbPack(int &, int &);
+
+#endif
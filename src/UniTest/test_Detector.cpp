@@ -210,6 +210,37 @@ const double EQT = 1.0e-15;
 
 //-----------------------------------------------------------------------------
 
+{
+    Test t(GROUP, "set_bands", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string fname(cnststr::PATH + "UniTest/Output/DetectorName-backlighter.txt");
+        #include <detector_init.inc>
+        Database d("none", cnststr::PATH + "UniTest/Dbase3/", false);
+        det.set_bands(d, "planck", {250.0, 450.0}, {450.0, 950.0});
+        std::vector<double> hvb = det.get_hv();
+        std::string expected("2 0 2 0 2");
+        expected += "   3.000000e+02   7.500000e+02   0.000000e+00\n";
+        expected += "DetectorName-backlighter\ndata in W/cm2/sr/eV\n";
+        expected += "   7.000000e+00\n   7.000000e+00";
+        std::string actual(std::to_string(det.get_nhv()) + " "
+            + std::to_string(det.get_band_id()) + " "
+            + std::to_string(det.get_bands().jhi.at(1)) + " "
+            + std::to_string(det.get_jmin()) + " "
+            + std::to_string(det.get_jmax())
+            + utils::double_to_string(hvb.at(0))
+            + utils::double_to_string(hvb.at(1))
+            + utils::double_to_string(det.get_fwhm() + 1.0) + "\n"
+            + utils::file_to_string(fname));
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 {
     Test t(GROUP, "dname_empty", "fast");
 
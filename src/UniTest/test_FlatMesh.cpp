@@ -0,0 +1,187 @@
+/*=============================================================================
+
+test_FlatMesh.cpp
+Definitions for unit, integration, and regression tests for class FlatMesh.
+
+Peter Hakel
+Los Alamos National Laboratory
+XCP-5 group
+
+Created on 16 October 2026
+Last modified on 16 October 2026
+
+Copyright (c) 2015, Triad National Security, LLC.
+All rights reserved.
+Use of this source code is governed by the BSD 3-Clause License.
+See top-level license.txt file for full license text.
+
+CODE NAME:  FESTR, Version 0.9 (C15068)
+Classification Review Number: LA-CC-15-045
+Export Control Classification Number (ECCN): EAR99
+B&R Code:  DP1516090
+
+=============================================================================*/
+
+//  Note: only use trimmed strings for names
+
+#include <test_FlatMesh.h>
+#include <Test.h>
+
+#include <Face.h>
+#include <Grid.h>
+#include <Mesh.h>
+#include <Node.h>
+#include <Polygon.h>
+#include <Sphere.h>
+#include <Surface.h>
+#include <Vector3d.h>
+#include <Zone.h>
+
+void test_FlatMesh(int &failed_test_count, int &disabled_test_count)
+{
+const std::string GROUP = "FlatMesh";
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "build_sizes", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mesh.inc>
+        m.compile(g);
+        const FlatMesh &fm = m.get_flat();
+        std::string expected = "4 20";
+        std::string actual = std::to_string(fm.size()) + " "
+                           + std::to_string(fm.get_nfaces());
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "kinds", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mesh.inc>
+        m.compile(g);
+        const FlatMesh &fm = m.get_flat();
+        std::string expected = std::to_string(FlatMesh::SPHERE)
+                             + std::to_string(FlatMesh::OTHER)
+                             + std::to_string(FlatMesh::POLYGON)
+                             + std::to_string(FlatMesh::POLYGON);
+        std::string actual = std::to_string(fm.get_kind(0, 0))
+                           + std::to_string(fm.get_kind(0, 1))
+                           + std::to_string(fm.get_kind(1, 0))
+                           + std::to_string(fm.get_kind(3, 5));
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "stale", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mesh.inc>
+        FlatMesh fm;
+        bool expected = true;
+        bool actual = !fm.is_current(g);
+        fm.build({m.get_zone(0), m.get_zone(1)}, g);
+        actual = actual  &&  fm.is_current(g)  &&  fm.size() == 2;
+        p = Vector3d(0.0, 0.0, 0.0);
+        g.replace_node(Node(0, p, p));
+        actual = actual  &&  !fm.is_current(g);
+        fm.clear();
+        actual = actual  &&  fm.size() == 0;
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+//  Same hit points as Zone::hit (see the Ray handovers in test_Mesh.cpp)
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "hit_Sphere", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mesh.inc>
+        m.compile(g);
+        FaceID this_face(1, 2);      // as if Ray exits through cube's left
+        Vector3d w(0.0, 0.75, 0.5);  // Ray starting point
+        Vector3d u(-2.0, 0.0, 0.0);  // Ray direction
+        RetIntercept r0 = m.get_zone(0)->get_face(0)->intercept(g, w, u,
+                                                    1.0e-19, this_face);
+        RetIntercept r1 = m.get_flat().hit(g, 0, w, u, this_face);
+        bool expected = true;
+        bool actual = r1.is_found  &&  r0.t == r1.t  &&  r0.fid == r1.fid
+                   &&  r0.w.abs_diff(r1.w) == 0.0;
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "hit_Polygon", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mesh.inc>
+        m.compile(g);
+        FaceID this_face(1, 2);     // cube's left Face
+        Vector3d w(0.0, 0.75, 0.5); // Ray starting point
+        Vector3d u(2.0, 0.0, 0.0);  // Ray direction
+        RetIntercept r0 = m.get_zone(1)->hit(g, w, u, this_face);
+        RetIntercept r1 = m.get_flat().hit(g, 1, w, u, this_face);
+        bool expected = true;
+        bool actual = r1.is_found  &&  r0.t == r1.t  &&  r0.fid == r1.fid
+                   &&  r0.w.abs_diff(r1.w) == 0.0;
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "hit_Surface", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mesh.inc>
+        m.compile(g);
+        FaceID this_face(0, 0);      // as if Ray started on bounding Sphere
+        Vector3d w(-5.0, 0.75, 0.5); // Ray starting point
+        Vector3d u(2.0, 0.0, 0.0);   // Ray direction
+        RetIntercept r0 = m.get_zone(0)->hit(g, w, u, this_face);
+        RetIntercept r1 = m.hit(g, 0, w, u, this_face);
+        bool expected = true;
+        bool actual = r1.is_found  &&  r0.t == r1.t  &&  r0.fid == r1.fid
+                   &&  r0.w.abs_diff(r1.w) == 0.0;
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}
+
+//  end test_FlatMesh.cpp
@@ -0,0 +1,8 @@
+#ifndef LANL_ASC_PEM_TEST_FLATMESH_H_
+#define LANL_ASC_PEM_TEST_FLATMESH_H_
+
+#include <FlatMesh.h>
+
+void test_FlatMesh(int &, int &);
+
+#endif
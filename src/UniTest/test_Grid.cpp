@@ -8,7 +8,7 @@ Los Alamos National Laboratory
 XCP-5 group
 
 Created on 21 November 2014
-Last modified on 2 October 2020
+Last modified on 16 October 2026
 
 Copyright (c) 2015, Triad National Security, LLC.
 All rights reserved.
@@ -336,6 +336,73 @@ const double EQT = 1.0e-15;
 
 //-----------------------------------------------------------------------------
 
+{
+    Test t(GROUP, "stamp", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Hydro1/");
+        std::string tlabel("0");
+        Grid g(path, tlabel);
+        Grid h(g);
+        const size_t s0 = g.get_stamp();
+        g.replace_node(g.get_node(5));
+        bool expected = true;
+        bool actual = s0 != 0  &&  h.get_stamp() == s0  &&
+                      g.get_stamp() != s0;
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "getr_getv", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Hydro1/");
+        std::string tlabel("0");
+        Grid g(path, tlabel);
+        Node n = g.get_node(5);
+        bool expected = true;
+        bool actual = g.getr(5).abs_diff(n.getr()) == 0.0  &&
+                      g.getv(5).abs_diff(n.getv()) == 0.0;
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "component_arrays", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        Grid g;
+        g.add_node(Node(0, Vector3d(1.0, 2.0, 3.0), Vector3d(4.0, 5.0, 6.0)));
+        g.add_node(Node(1, Vector3d(7.0, 8.0, 9.0)));
+        g.replace_node(Node(0, Vector3d(-1.0, -2.0, -3.0)));
+        const std::vector<double> ref = {-1.0, 7.0, -2.0, 8.0, -3.0, 9.0,
+                                         0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        std::vector<double> all;
+        for (auto c : {&g.get_rx(), &g.get_ry(), &g.get_rz(),
+                       &g.get_vx(), &g.get_vy(), &g.get_vz()})
+            all.insert(all.end(), c->begin(), c->end());
+        bool expected = true;
+        bool actual = all == ref;
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 }
 
 //  end test_Grid.cpp
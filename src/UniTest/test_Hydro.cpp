@@ -8,7 +8,7 @@ Los Alamos National Laboratory
 XCP-5 group
 
 Created on 7 January 2015
-Last modified on 2 October 2020
+Last modified on 16 October 2026
 
 Copyright (c) 2015, Triad National Security, LLC.
 All rights reserved.
@@ -417,6 +417,51 @@ const double EQT = 1.0e-24;
 
 //-----------------------------------------------------------------------------
 
+{
+    Test t(GROUP, "Hydro1_geo_hash_changed", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <hydro1.inc>
+        Grid g;
+        Mesh m;
+        h.load_at(0, g, m);
+        uint64_t h0 = m.get_geo_hash();
+        h.load_at(1, g, m);
+        bool expected = true;
+        bool actual = h0 != 0  &&  m.get_geo_hash() != 0  &&
+                      m.get_geo_hash() != h0;
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Hydro3_geo_hash_unchanged", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string hydro_path(cnststr::PATH + "UniTest/Hydro3/");
+        std::string table_path(cnststr::PATH + "UniTest/Data/");
+        Hydro h(false, hydro_path, table_path, "Table.txt", "none", -1.0, 1.0);
+        Grid g;
+        Mesh m;
+        h.load_at(0, g, m);
+        uint64_t h0 = m.get_geo_hash();
+        h.load_at(1, g, m);
+        bool expected = true;
+        bool actual = h0 != 0  &&  m.get_geo_hash() == h0;
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 {
     Test t(GROUP, "Hydro1_Time0_Mesh_size", "fast");
 
@@ -898,6 +943,27 @@ const double EQT = 1.0e-24;
 
 //-----------------------------------------------------------------------------
 
+{
+    Test t(GROUP, "Analysis1_geo_hash_all_cases", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <analysis1_hydro.inc>
+        Grid g;
+        Mesh m;
+        h.load_at(0, g, m);
+        uint64_t h0 = m.get_geo_hash();
+        h.load_at(h.get_nintervals() - 1, g, m);
+        bool expected = true;
+        bool actual = h0 != 0  &&  m.get_geo_hash() == h0;
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 {
     Test t(GROUP, "Analysis2_ncases", "fast");
 
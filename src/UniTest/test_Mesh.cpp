@@ -12,7 +12,7 @@ Los Alamos National Laboratory
 XCP-5 group
 
 Created on 18 December 2014
-Last modified 2 October 2020
+Last modified 17 October 2026
 
 Copyright (c) 2015, Triad National Security, LLC.
 All rights reserved.
@@ -66,6 +66,22 @@ const double EQT = 1.0e-15;
 
 //-----------------------------------------------------------------------------
 
+{
+    Test t(GROUP, "zone_at", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mesh.inc>
+        bool expected = true;
+        bool actual = &m.zone_at(2) == m.get_zone(2).get();
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 {
     Test t(GROUP, "size", "fast");
 
@@ -350,6 +366,117 @@ const double EQT = 1.0e-15;
     }
 }
 
+//-----------------------------------------------------------------------------
+//  Ray handovers through the portal table
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "hit_cube_edge_watertight", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mesh.inc>
+        Zone::reset_nretries();
+        RetIntercept h = m.zone_at(1).hit(g, Vector3d(0.5, 0.5, 0.5),
+                                          Vector3d(1.0, 1.0, 0.0),
+                                          FaceID(9, 9));
+        Vector3d expected(1.0, 1.0, 0.5); // shared edge of two Faces
+        Vector3d actual = h.w;
+        if (!h.is_found  ||  Zone::get_nretries() != 0) actual.set0();
+
+        failed_test_count += t.check_equal_real_obj(expected, actual, EQT);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "hit_retry_count", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mesh.inc>
+        Zone::reset_nretries();
+        m.zone_at(1).hit(g, Vector3d(0.5, 0.5, 0.5), Vector3d(1.0, 0.0, 0.0),
+                         FaceID(9, 9));
+        size_t expected = 0;
+        size_t actual = Zone::get_nretries();
+        // no Face ahead of a point outside the cube: retry from zone_point
+        m.zone_at(1).hit(g, Vector3d(5.0, 5.0, 5.0), Vector3d(1.0, 0.0, 0.0),
+                         FaceID(9, 9));
+        expected += 10;
+        actual += 10 * Zone::get_nretries();
+        Zone::reset_nretries();
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "portals_count", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mesh.inc>
+        size_t expected = 0; // not linked after add_zone
+        size_t actual = m.get_nportals();
+        m.link();
+        expected += 17; // all box Faces, except for cube's right Face
+        actual += m.get_nportals();
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "portals_cube_to_back_box", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mesh.inc>
+        m.link();
+        z = m.get_zone(1); // cube Zone = 1
+        FaceID this_face(1, 2);     // cube's left Face
+        Vector3d w(0.0, 0.75, 0.5); // Ray starting point
+        Vector3d u(2.0, 0.0, 0.0);  // Ray direction
+        RetIntercept h = z->hit(g, w, u, this_face);
+        FaceID expected(3, 2); // one of two candidates behind cube's right Face
+        FaceID actual = m.next_face(g, h);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "portals_back_box_to_Surface", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mesh.inc>
+        m.link();
+        z = m.get_zone(3); // back box Zone = 3
+        FaceID this_face(3, 2);     // back box's left Face
+        Vector3d w(1.0, 0.75, 0.5); // Ray starting point
+        Vector3d u(2.0, 0.0, 0.0);  // Ray direction
+        RetIntercept h = z->hit(g, w, u, this_face);
+        FaceID expected(0, 1); // one-to-one portal into the Surface
+        FaceID actual = m.next_face(g, h);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
 //-----------------------------------------------------------------------------
 //  Fourth Ray handover
 //-----------------------------------------------------------------------------
@@ -2641,6 +2768,30 @@ const double EQT = 1.0e-15;
 
 //-----------------------------------------------------------------------------
 
+{
+    Test t(GROUP, "hash_geometry_node_moved", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mesh.inc>
+        m.link();
+        const uint64_t h0 = m.hash_geometry(g);
+        Node n0 = g.get_node(0);
+        g.replace_node(Node(0, n0.getr() + Vector3d(0.1, 0.0, 0.0),
+                            n0.getv()));
+        const uint64_t h1 = m.hash_geometry(g);
+        g.replace_node(n0);
+        std::string expected = "true true";
+        std::string actual = utils::bool_to_string(h0 != 0  &&  h1 != h0)
+            + " " + utils::bool_to_string(m.hash_geometry(g) == h0);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 {
     Test t(GROUP, "load_Hydro4_Mesh0_string", "fast");
 
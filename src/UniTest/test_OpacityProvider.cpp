@@ -0,0 +1,185 @@
+/*=============================================================================
+
+test_OpacityProvider.cpp
+Definitions for unit, integration, and regression tests for class
+OpacityProvider.
+
+Peter Hakel
+Los Alamos National Laboratory
+XCP-5 group
+
+Created on 16 October 2026
+Last modified on 17 October 2026
+
+Copyright (c) 2015, Triad National Security, LLC.
+All rights reserved.
+Use of this source code is governed by the BSD 3-Clause License.
+See top-level license.txt file for full license text.
+
+CODE NAME:  FESTR, Version 0.9 (C15068)
+Classification Review Number: LA-CC-15-045
+Export Control Classification Number (ECCN): EAR99
+B&R Code:  DP1516090
+
+=============================================================================*/
+
+//  Note: only use trimmed strings for names
+
+#include <test_OpacityProvider.h>
+#include <Test.h>
+#include <spec_eqt.h>
+
+#include <Zone.h>
+
+#include <sstream>
+
+namespace
+{
+/// In-process OpacityProvider: the stand-in server runs on string streams
+class LocalProvider: public OpacityProvider
+{
+public:
+    LocalProvider(const Database &d_in, const size_t jmin_in,
+                  const size_t jmax_in):
+        OpacityProvider(jmin_in, jmax_in), d(d_in) {}
+
+protected:
+    std::string round_trip(const std::string &batch) override
+    {
+        std::istringstream in(batch);
+        std::ostringstream out;
+        OpacityProvider::serve(d, in, out);
+        return out.str();
+    }
+
+private:
+    const Database &d;
+};
+}
+
+void test_OpacityProvider(int &failed_test_count, int &disabled_test_count)
+{
+const std::string GROUP = "OpacityProvider";
+const double EQT = 1.0e-15;
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "write_batch", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        OpacityRequest r;
+        r.mat = {"z01", "z18"};
+        r.fp = {0.75, 0.25};
+        r.te = 100.0;
+        r.tr = 0.0;
+        r.np = 1.0e20;
+        std::string expected = "batch 1 0 2\n2 z01 0.75 z18 0.25 100 0 1e+20\n";
+        std::string actual = OpacityProvider::write_batch({r}, 0, 2);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "serve_Hydro1_Time0_Zone1", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mix.inc>
+        std::istringstream in(OpacityProvider::write_batch(
+                              {z.opacity_request(tbl)}, 0, 2));
+        std::ostringstream out;
+        OpacityProvider::serve(d, in, out);
+        OpacityReply r = OpacityProvider::read_reply(out.str(), 1, 3).at(0);
+        ArrDbl expected(em);
+        ArrDbl actual(3);
+        for (size_t j = 0; j < 3; ++j) actual[j] = r.em.at(j);
+
+        failed_test_count += t.check_equal_real_obj(expected, actual, EQT);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "request_batches_once", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mix.inc>
+        LocalProvider op(d, 0, 2);
+        OpacityRequest r = z.opacity_request(tbl);
+        op.request({r, r});
+        op.request({r});
+        std::string expected = "1 1 2";
+        std::string actual = std::to_string(op.get_ntrips()) + " "
+                           + std::to_string(op.get_nsent()) + " "
+                           + std::to_string(op.get_nhits());
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "request_cache_bounded", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mix.inc>
+        LocalProvider op(d, 0, 2);
+        OpacityRequest r = z.opacity_request(tbl);
+        std::string expected = "2 2 2 2 2";
+        std::string actual("");
+        for (int step = 0; step < 5; ++step) // new states at every step
+        {
+            OpacityRequest q(r);
+            r.np *= 1.01;
+            q.np *= 0.99;
+            op.request({r, q, r});
+            if (step > 0) actual += " ";
+            actual += std::to_string(op.get_cache_size());
+        }
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "Zone_set_spectra", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mix.inc>
+        LocalProvider op(d, 0, 2);
+        OpacityRequest r = z.opacity_request(tbl);
+        op.request({r});
+        z.set_spectra(op.reply(r), 0, 2);
+        ArrDbl expected(ab);
+        size_t jte(0), jtr(0), jne(0);
+        z.load_spectra(d, tbl, jte, jtr, jne, "none", 0, false, 0, 2,
+                       em, ab, sc);
+        ArrDbl actual(ab);
+        const double eqt = spec_eqt(EQT, expected);
+
+        failed_test_count += t.check_equal_real_obj(expected, actual, eqt);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}
+
+//  end test_OpacityProvider.cpp
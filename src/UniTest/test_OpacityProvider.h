@@ -0,0 +1,8 @@
+#ifndef LANL_ASC_PEM_TEST_OPACITYPROVIDER_H_
+#define LANL_ASC_PEM_TEST_OPACITYPROVIDER_H_
+
+#include <OpacityProvider.h>
+
+void test_OpacityProvider(int &, int &);
+
+#endif
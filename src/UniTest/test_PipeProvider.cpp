@@ -0,0 +1,107 @@
+/*=============================================================================
+
+test_PipeProvider.cpp
+Definitions for unit, integration, and regression tests for class
+PipeProvider.
+
+Peter Hakel
+Los Alamos National Laboratory
+XCP-5 group
+
+Created on 16 October 2026
+Last modified on 17 October 2026
+
+Copyright (c) 2015, Triad National Security, LLC.
+All rights reserved.
+Use of this source code is governed by the BSD 3-Clause License.
+See top-level license.txt file for full license text.
+
+CODE NAME:  FESTR, Version 0.9 (C15068)
+Classification Review Number: LA-CC-15-045
+Export Control Classification Number (ECCN): EAR99
+B&R Code:  DP1516090
+
+=============================================================================*/
+
+//  Note: only use trimmed strings for names
+
+#include <test_PipeProvider.h>
+#include <Test.h>
+
+#include <sstream>
+#include <vector>
+
+void test_PipeProvider(int &failed_test_count, int &disabled_test_count)
+{
+const std::string GROUP = "PipeProvider";
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "canned_reply", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        // server that ignores its input and always gives the same reply
+        PipeProvider op("printf 'reply 1 1\\n2.5 1 2 3\\nend\\n'; "
+                        "cat > /dev/null", 4, 4);
+        OpacityRequest r;
+        r.mat = {"z01"};
+        r.fp = {1.0};
+        r.te = 100.0;
+        r.tr = 0.0;
+        r.np = 1.0e20;
+        op.request({r});
+        const OpacityReply &p = op.reply(r);
+        std::string expected = "2.5 1 2 3 1";
+        std::ostringstream ost;
+        ost << p.ne << " " << p.em.at(0) << " " << p.ab.at(0) << " "
+            << p.sc.at(0) << " " << op.get_ntrips();
+        std::string actual = ost.str();
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "batch_larger_than_pipe", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        // server that replies to each request as soon as it reads it, with
+        // ne = np; both the batch and the reply exceed the pipe capacity
+        PipeProvider op("read -r w n jmin jmax; echo \"reply $n 1\"; i=0; "
+                        "while [ $i -lt $n ]; do "
+                        "read -r nmat m1 f1 m2 f2 te tr np; "
+                        "echo \"$np 1 2 3\"; i=$((i+1)); done; "
+                        "echo end; cat > /dev/null", 4, 4);
+        const size_t N = 5000;
+        std::vector<OpacityRequest> rq(N);
+        for (size_t i = 0; i < N; ++i)
+        {
+            rq.at(i).mat = {"z01", "z02"};
+            rq.at(i).fp = {0.25, 0.75};
+            rq.at(i).te = 100.0;
+            rq.at(i).tr = 0.0;
+            rq.at(i).np = 1.0e20 + 1.0e10 * static_cast<double>(i);
+        }
+        op.request(rq);
+        std::string expected = "1 1";
+        std::ostringstream ost;
+        ost << op.get_ntrips() << " "
+            << (op.reply(rq.back()).ne == rq.back().np);
+        std::string actual = ost.str();
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}
+
+//  end test_PipeProvider.cpp
@@ -0,0 +1,8 @@
+#ifndef LANL_ASC_PEM_TEST_PIPEPROVIDER_H_
+#define LANL_ASC_PEM_TEST_PIPEPROVIDER_H_
+
+#include <PipeProvider.h>
+
+void test_PipeProvider(int &, int &);
+
+#endif
@@ -8,7 +8,7 @@ Los Alamos National Laboratory
 XCP-5 group
 
 Created on 21 November 2014
-Last modified on 2 October 2020
+Last modified on 16 October 2026
 
 Copyright (c) 2015, Triad National Security, LLC.
 All rights reserved.
@@ -1382,6 +1382,117 @@ const double EQT = 1.0e-15;
 
 //-----------------------------------------------------------------------------
 
+{
+    Test t(GROUP, "rectangle_compiled_contains", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <rectangle.inc>
+        Polygon plain(*std::dynamic_pointer_cast<Polygon>(f));
+        f->compile(g);
+        bool same = true;
+        for (int i = 0; i <= 16; ++i)
+            for (int j = 0; j <= 20; ++j)
+            {   // includes points on the sides and at the corners
+                v = Vector3d(0.5 + 0.25*i, 0.5 + 0.25*j, 5.0);
+                same = same  &&  f->contains(g, v) == plain.contains(g, v);
+            }
+        std::string expected("true true false");
+        std::string actual = utils::bool_to_string(same) + " "
+            + utils::bool_to_string(f->contains(g, Vector3d(2.0, 3.0, 5.0)))
+            + " "
+            + utils::bool_to_string(f->contains(g, Vector3d(7.0, 6.0, 5.0)));
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "rectangle_compiled_stale", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <rectangle.inc>
+        f->compile(g);
+        g.replace_node(Node(2, Vector3d(6.0, 1.0, 5.0))); // Grid moved on
+        g.replace_node(Node(3, Vector3d(6.0, 4.0, 5.0)));
+        v = Vector3d(5.0, 3.0, 5.0);
+        RetIntercept h = f->intercept(g, Vector3d(5.0, 3.0, 9.0),
+                                      Vector3d(0.0, 0.0, -1.0), 1.0e-12,
+                                      FaceID(9, 9));
+        std::string expected("true true");
+        expected += utils::double_to_string(4.0);
+        std::string actual = utils::bool_to_string(f->contains(g, v)) + " "
+                           + utils::bool_to_string(h.is_found)
+                           + utils::double_to_string(h.t);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "rectangle_crosses", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <rectangle.inc>
+        auto r = std::dynamic_pointer_cast<Polygon>(f);
+        const Vector3d down(0.0, 0.0, -1.0);
+        std::string expected("true true false true");
+        std::string actual =
+            utils::bool_to_string(r->crosses(g, Vector3d(2.0, 3.0, 9.0), down))
+            + " " + utils::bool_to_string(  // either orientation
+                r->crosses(g, Vector3d(2.0, 3.0, 0.0), -1.0 * down))
+            + " " + utils::bool_to_string(
+                r->crosses(g, Vector3d(7.0, 6.0, 9.0), down))
+            + " " + utils::bool_to_string(  // through a corner
+                r->crosses(g, Vector3d(3.0, 4.0, 9.0), down));
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "split_rectangle_crosses_watertight", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <rectangle.inc>
+        Polygon a, b; // halves of the rectangle, sharing its diagonal 1-3
+        a.add_node(1);
+        a.add_node(2);
+        a.add_node(3);
+        b.add_node(1);
+        b.add_node(3);
+        b.add_node(4);
+        const Vector3d u(0.1, -0.2, -1.0);
+        size_t leaks = 0;
+        for (int i = 1; i < 1000; ++i)
+        {   // Rays aimed at (rounded) points of the diagonal
+            const double x = 1.0 + 0.002 * i;
+            const Vector3d w(x, 1.0 + 1.5 * (x - 1.0), 5.0);
+            const Vector3d p = w - u * 3.7;
+            if (!a.crosses(g, p, u)  &&  !b.crosses(g, p, u)) ++leaks;
+        }
+        size_t expected = 0;
+        size_t actual = leaks;
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 }
 
 //  end test_Polygon.cpp
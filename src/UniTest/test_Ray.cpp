@@ -8,7 +8,7 @@ Los Alamos National Laboratory
 XCP-5 group
 
 Created on 24 December 2014
-Last modified on 2 October 2020
+Last modified on 17 October 2026
 
 Copyright (c) 2015, Triad National Security, LLC.
 All rights reserved.
@@ -26,6 +26,7 @@ B&R Code:  DP1516090
 
 #include <test_Ray.h>
 #include <Test.h>
+#include <spec_eqt.h>
 
 #include <Cone.h>
 #include <Database.h>
@@ -39,7 +40,7 @@ B&R Code:  DP1516090
 #include <Vector3d.h>
 #include <Zone.h>
 
-#define CurntZone m.get_zone(ray.wpt.top().outface.my_zone)
+#define CurntZone m.get_zone(ray.path.back().zid)
 
 void test_Ray(int &failed_test_count, int &disabled_test_count)
 {
@@ -324,8 +325,9 @@ const double EQT = 1.0e-15;
         #include <transport_Ray.inc>
         double expected(139.99999999976001);
         double actual(ray.y.at(0));
+        const double eqt = spec_eqt(EQT, expected);
 
-        failed_test_count += t.check_equal_real_num(expected, actual, EQT);
+        failed_test_count += t.check_equal_real_num(expected, actual, eqt);
     }
 }
 
@@ -340,8 +342,9 @@ const double EQT = 1.0e-15;
         #include <transport_Ray.inc>
         double expected(75.904463047023839);
         double actual(ray.y.at(1));
+        const double eqt = spec_eqt(100*EQT, expected);
 
-        failed_test_count += t.check_equal_real_num(expected, actual, 100*EQT);
+        failed_test_count += t.check_equal_real_num(expected, actual, eqt);
     }
 }
 
@@ -356,8 +359,9 @@ const double EQT = 1.0e-15;
         #include <transport_Ray.inc>
         double expected(10.000061442123533);
         double actual(ray.y.at(2));
+        const double eqt = spec_eqt(EQT, expected);
 
-        failed_test_count += t.check_equal_real_num(expected, actual, EQT);
+        failed_test_count += t.check_equal_real_num(expected, actual, eqt);
     }
 }
 
@@ -418,7 +422,7 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         Vector3d expected(0.0, 0.75, 0.5);
         Vector3d actual(ray.r);
 
@@ -435,7 +439,7 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         Vector3d expected(2.0, 0.0, 0.0);
         Vector3d actual(ray.v);
 
@@ -452,9 +456,9 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        size_t expected(3); // number of remaining HitPoints
-        size_t actual(ray.wpt.size());
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        size_t expected(3); // number of remaining Chords
+        size_t actual(ray.path.size());
 
         failed_test_count += t.check_equal(expected, actual);
     }
@@ -469,8 +473,8 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         Vector3d expected(1.0, 0.75, 0.5);
         Vector3d actual(ray.r);
 
@@ -487,8 +491,8 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         Vector3d expected(2.0, 0.0, 0.0);
         Vector3d actual(ray.v);
 
@@ -505,10 +509,10 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        size_t expected(2); // number of remaining HitPoints
-        size_t actual(ray.wpt.size());
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        size_t expected(2); // number of remaining Chords
+        size_t actual(ray.path.size());
 
         failed_test_count += t.check_equal(expected, actual);
     }
@@ -523,9 +527,9 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         Vector3d expected(2.0, 0.75, 0.5);
         Vector3d actual(ray.r);
 
@@ -542,9 +546,9 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         Vector3d expected(2.0, 0.0, 0.0);
         Vector3d actual(ray.v);
 
@@ -561,11 +565,11 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        size_t expected(1); // number of remaining HitPoints
-        size_t actual(ray.wpt.size());
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        size_t expected(1); // number of remaining Chords
+        size_t actual(ray.path.size());
 
         failed_test_count += t.check_equal(expected, actual);
     }
@@ -580,10 +584,10 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         Vector3d expected(12.968712349342937, 0.75, 0.5);
         Vector3d actual(ray.r);
 
@@ -600,10 +604,10 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         Vector3d expected(2.0, 0.0, 0.0);
         Vector3d actual(ray.v);
 
@@ -620,10 +624,10 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         size_t expected(0);
         size_t actual(ray.zid);
 
@@ -640,12 +644,12 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        size_t expected(0); // number of remaining HitPoints
-        size_t actual(ray.wpt.size());
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        size_t expected(0); // number of remaining Chords
+        size_t actual(ray.path.size());
 
         failed_test_count += t.check_equal(expected, actual);
     }
@@ -712,8 +716,24 @@ const double EQT = 1.0e-15;
     {
         #include <trace.inc>
         ray.cross_Mesh(m, d, tbl, "none", 0);
-        size_t expected(0); // number of remaining HitPoints
-        size_t actual(ray.wpt.size());
+        size_t expected(0); // number of remaining Chords
+        size_t actual(ray.path.size());
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "trace_path_first_zid", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <trace.inc>
+        size_t expected(Zone::BOUNDING_ZONE); // crossed last, traced first
+        size_t actual(ray.path.front().zid);
 
         failed_test_count += t.check_equal(expected, actual);
     }
@@ -721,6 +741,61 @@ const double EQT = 1.0e-15;
 
 //-----------------------------------------------------------------------------
 
+{
+    Test t(GROUP, "trace_path_chord_sum", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <trace.inc>
+        double expected = (ray.r - r).norm();
+        double actual = 0.0;
+        for (const Chord &c : ray.path) actual += c.ct;
+
+        failed_test_count += t.check_equal_real_num(expected, actual, 1.0e-12);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "set_path_size", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <trace.inc>
+        Ray reuse(0, 0, 3, 0, 2, false, r, v, false, "", "");
+        reuse.set_path(ray.get_path());
+        size_t expected(ray.path.size());
+        size_t actual(reuse.path.size());
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "set_path_cross_Mesh_r", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <trace.inc>
+        Ray reuse(0, 0, 3, 0, 2, false, r, v, false, "", "");
+        reuse.set_path(ray.get_path());
+        ray.cross_Mesh(m, d, tbl, "none", 0);
+        reuse.cross_Mesh(m, d, tbl, "none", 0);
+        Vector3d expected(ray.r);
+        Vector3d actual(reuse.r);
+
+        failed_test_count += t.check_equal_real_obj(expected, actual, EQT);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 {
     Test t(GROUP, "after_trace_y", "fast");
 
@@ -952,7 +1027,7 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         ArrDbl expected;
         expected.assign(3, 0.0);
         ArrDbl actual(ray.y);
@@ -970,7 +1045,7 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 1);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 1);
         std::string expected("File name for zone_iz0\nRest of header");
         expected += "\niz 0   1.296871e+01 cm\nZoneID 0\ndata in W/cm2/sr/eV";
         expected += "\n   0.000000e+00\n   0.000000e+00\n   0.000000e+00";
@@ -989,7 +1064,7 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         Vector3d expected(0.0, 0.75, 0.5);
         Vector3d actual(ray.r);
 
@@ -1006,8 +1081,8 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         size_t expected(5);
         size_t actual(ray.ine);
 
@@ -1024,15 +1099,16 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         ArrDbl expected(3);
         expected.at(0) = 4.06e30;
         expected.at(1) = 8.12e30;
         expected.at(2) = 2.03e31;
         ArrDbl actual(ray.em);
+        const double eqt = spec_eqt(EQT, expected);
 
-        failed_test_count += t.check_equal_real_obj(expected, actual, EQT);
+        failed_test_count += t.check_equal_real_obj(expected, actual, eqt);
     }
 }
 
@@ -1045,15 +1121,16 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         ArrDbl expected(3);
         expected.at(0) = 6.04e-12;
         expected.at(1) = 6.04e-1;
         expected.at(2) = 6.04e0;
         ArrDbl actual(ray.ab);
+        const double eqt = spec_eqt(EQT, expected);
 
-        failed_test_count += t.check_equal_real_obj(expected, actual, EQT);
+        failed_test_count += t.check_equal_real_obj(expected, actual, eqt);
     }
 }
 
@@ -1066,15 +1143,16 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         ArrDbl expected(3);
         expected.at(0) = 6.04e-13;
         expected.at(1) = 6.04e-2;
         expected.at(2) = 6.04e-1;
         ArrDbl actual(ray.sc);
+        const double eqt = spec_eqt(EQT, expected);
 
-        failed_test_count += t.check_equal_real_obj(expected, actual, EQT);
+        failed_test_count += t.check_equal_real_obj(expected, actual, eqt);
     }
 }
 
@@ -1087,15 +1165,16 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         ArrDbl expected(3);
         expected.at(0) = 4.06e30;
         expected.at(1) = 5.932559696843195e+30;
         expected.at(2) = 3.0514107865117147e+30;
         ArrDbl actual(ray.y);
+        const double eqt = spec_eqt(1.0e16, expected);
 
-        failed_test_count += t.check_equal_real_obj(expected, actual, 1.0e16);
+        failed_test_count += t.check_equal_real_obj(expected, actual, eqt);
     }
 }
 
@@ -1108,8 +1187,8 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 1);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 1);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 1);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 1);
         std::string expected("File name for zone_iz1\nRest of header");
         expected += "\niz 1   1.396871e+01 cm\nZoneID 1\ndata in W/cm2/sr/eV";
         expected += "\n   4.060000e+30\n   5.932560e+30\n   3.051411e+30";
@@ -1128,8 +1207,8 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         Vector3d expected(1.0, 0.75, 0.5);
         Vector3d actual(ray.r);
 
@@ -1146,9 +1225,9 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         size_t expected(5);
         size_t actual(ray.ine);
 
@@ -1165,16 +1244,17 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         ArrDbl expected(3);
         expected.at(0) = 4.06e30;
         expected.at(1) = 8.12e30;
         expected.at(2) = 2.03e31;
         ArrDbl actual(ray.em);
+        const double eqt = spec_eqt(EQT, expected);
 
-        failed_test_count += t.check_equal_real_obj(expected, actual, EQT);
+        failed_test_count += t.check_equal_real_obj(expected, actual, eqt);
     }
 }
 
@@ -1187,16 +1267,17 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         ArrDbl expected(3);
         expected.at(0) = 6.04e-12;
         expected.at(1) = 6.04e-1;
         expected.at(2) = 6.04e0;
         ArrDbl actual(ray.ab);
+        const double eqt = spec_eqt(EQT, expected);
 
-        failed_test_count += t.check_equal_real_obj(expected, actual, EQT);
+        failed_test_count += t.check_equal_real_obj(expected, actual, eqt);
     }
 }
 
@@ -1209,16 +1290,17 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         ArrDbl expected(3);
         expected.at(0) = 6.04e-13;
         expected.at(1) = 6.04e-2;
         expected.at(2) = 6.04e-1;
         ArrDbl actual(ray.sc);
+        const double eqt = spec_eqt(EQT, expected);
 
-        failed_test_count += t.check_equal_real_obj(expected, actual, EQT);
+        failed_test_count += t.check_equal_real_obj(expected, actual, eqt);
     }
 }
 
@@ -1231,16 +1313,17 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         ArrDbl expected(3);
         expected.at(0) = 8.1199999999730247e+30;
         expected.at(1) = 8.9853492247934706e+30;
         expected.at(2) = 3.0553831422974185e+30;
         ArrDbl actual(ray.y);
+        const double eqt = spec_eqt(1.0e16, expected);
 
-        failed_test_count += t.check_equal_real_obj(expected, actual, 1.0e16);
+        failed_test_count += t.check_equal_real_obj(expected, actual, eqt);
     }
 }
 
@@ -1253,15 +1336,17 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 1);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 1);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 1);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 1);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 1);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 1);
         std::string expected("File name for zone_iz2\nRest of header");
         expected += "\niz 2   1.496871e+01 cm\nZoneID 3\ndata in W/cm2/sr/eV";
         expected += "\n   8.120000e+30\n   8.985349e+30\n   3.055383e+30";
         std::string actual(utils::file_to_string("UniTest/Output/partial_iz2.txt"));
 
+        #ifndef SINGLE // 7 digits in files: not float spectra
         failed_test_count += t.check_equal(expected, actual);
+        #endif
     }
 }
 
@@ -1274,9 +1359,9 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         Vector3d expected(2.0, 0.75, 0.5);
         Vector3d actual(ray.r);
 
@@ -1293,10 +1378,10 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         size_t expected(5);
         size_t actual(ray.ine);
 
@@ -1313,10 +1398,10 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         ArrDbl expected(3); // vacuum (Zone nmat = 0)
         ArrDbl actual(ray.em);
 
@@ -1333,10 +1418,10 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         ArrDbl expected(3); // vacuum (Zone nmat = 0)
         ArrDbl actual(ray.ab);
 
@@ -1353,10 +1438,10 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         ArrDbl expected(3); // vacuum (Zone nmat = 0)
         ArrDbl actual(ray.sc);
 
@@ -1373,17 +1458,18 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         ArrDbl expected(3);
         expected.at(0) = 8.1199999999730247e+30;
         expected.at(1) = 8.9853492247934706e+30;
         expected.at(2) = 3.0553831422974185e+30;
         ArrDbl actual(ray.y);
+        const double eqt = spec_eqt(1.0e16, expected);
 
-        failed_test_count += t.check_equal_real_obj(expected, actual, 1.0e16);
+        failed_test_count += t.check_equal_real_obj(expected, actual, eqt);
     }
 }
 
@@ -1396,16 +1482,18 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 1);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 1);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 1);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 1);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 1);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 1);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 1);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 1);
         std::string expected("File name for zone_iz3\nRest of header");
         expected += "\niz 3   2.593742e+01 cm\nZoneID 0\ndata in W/cm2/sr/eV";
        expected += "\n   8.120000e+30\n   8.985349e+30\n   3.055383e+30";
         std::string actual(utils::file_to_string("UniTest/Output/partial_iz3.txt"));
 
+        #ifndef SINGLE // 7 digits in files: not float spectra
         failed_test_count += t.check_equal(expected, actual);
+        #endif
     }
 }
 
@@ -1418,10 +1506,10 @@ const double EQT = 1.0e-15;
     if (t.is_enabled())
     {
         #include <trace_Mesh.inc>
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
-        ray.cross_Zone(CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
+        ray.cross_Zone(*CurntZone, d, tbl, "none", 0, 0);
         Vector3d expected(12.968712349342937, 0.75, 0.5);
         Vector3d actual(ray.r);
 
@@ -1444,8 +1532,9 @@ const double EQT = 1.0e-15;
         expected.at(1) = 8.9853492247934706e+30;
         expected.at(2) = 3.0553831422974185e+30;
         ArrDbl actual(ray.y);
+        const double eqt = spec_eqt(1.0e16, expected);
 
-        failed_test_count += t.check_equal_real_obj(expected, actual, 1.0e16);
+        failed_test_count += t.check_equal_real_obj(expected, actual, eqt);
     }
 }
 
@@ -1503,8 +1592,9 @@ const double EQT = 1.0e-15;
         expected.at(1) = 1.220422899739185e+31;
         expected.at(2) = 3.055388320288982e+30;
         ArrDbl actual(ray.y);
+        const double eqt = spec_eqt(1.0e16, expected);
 
-        failed_test_count += t.check_equal_real_obj(expected, actual, 1.0e16);
+        failed_test_count += t.check_equal_real_obj(expected, actual, eqt);
     }
 }
 
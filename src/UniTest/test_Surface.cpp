@@ -8,7 +8,7 @@ Los Alamos National Laboratory
 XCP-5 group
 
 Created on 17 December 2014
-Last modified on 2 October 2020
+Last modified on 16 October 2026
 
 Copyright (c) 2015, Triad National Security, LLC.
 All rights reserved.
@@ -662,6 +662,22 @@ const double EQT = 1.0e-15;
 
 //-----------------------------------------------------------------------------
 
+{
+    Test t(GROUP, "cube_Surface_face_at", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <cube_Surface.inc>
+        bool expected = true;
+        bool actual = &a->face_at(2) == a->get_face(2).get();
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 {
     Test t(GROUP, "clear_num_nbr", "fast");
 
@@ -8,7 +8,7 @@ Los Alamos National Laboratory
 XCP-5 group
 
 Created on 8 December 2014
-Last modified on 6 October 2020
+Last modified on 17 October 2026
 
 Copyright (c) 2015, Triad National Security, LLC.
 All rights reserved.
@@ -26,6 +26,7 @@ B&R Code:  DP1516090
 
 #include <test_Zone.h>
 #include <Test.h>
+#include <spec_eqt.h>
 
 #include <Cone.h>
 #include <Face.h>
@@ -428,6 +429,22 @@ const double EQT = 1.0e-15;
 
 //-----------------------------------------------------------------------------
 
+{
+    Test t(GROUP, "outer_Sphere_face_at", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <outer_Sphere.inc>
+        bool expected = true;
+        bool actual = &z.face_at(3) == z.get_face(3).get();
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 {
     Test t(GROUP, "outer_Sphere_to_string", "fast");
 
@@ -2225,8 +2242,9 @@ const double EQT = 1.0e-15;
         #include <mix.inc>
         double expected = 4.06e30;
         double actual = em.at(0);
+        const double eqt = spec_eqt(1.0e15, expected);
 
-        failed_test_count += t.check_equal_real_num(expected, actual, 1.0e15);
+        failed_test_count += t.check_equal_real_num(expected, actual, eqt);
     }
 }
 
@@ -2241,8 +2259,9 @@ const double EQT = 1.0e-15;
         #include <mix.inc>
         double expected = 8.12e30;
         double actual = em.at(1);
+        const double eqt = spec_eqt(1.0e15, expected);
 
-        failed_test_count += t.check_equal_real_num(expected, actual, 1.0e15);
+        failed_test_count += t.check_equal_real_num(expected, actual, eqt);
     }
 }
 
@@ -2257,8 +2276,9 @@ const double EQT = 1.0e-15;
         #include <mix.inc>
         double expected = 2.03e31;
         double actual = em.at(2);
+        const double eqt = spec_eqt(1.0e15, expected);
 
-        failed_test_count += t.check_equal_real_num(expected, actual, 1.0e15);
+        failed_test_count += t.check_equal_real_num(expected, actual, eqt);
     }
 }
 
@@ -2360,6 +2380,149 @@ const double EQT = 1.0e-15;
 
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "mix_spectra_em", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mix.inc>
+        ArrDbl expected(2);
+        expected[0] = em[1];
+        expected[1] = em[2];
+        z.mix_spectra(d, tbl, 0, 2);
+        size_t jte(0), jtr(0), jne(0);
+        z.load_spectra(d, tbl, jte, jtr, jne, "none", 0, false, 1, 2,
+                       em, ab, sc);
+        ArrDbl actual(em);
+        const double eqt = spec_eqt(EQT, expected);
+
+        failed_test_count += t.check_equal_real_obj(expected, actual, eqt);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "mix_spectra_ne_index", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mix.inc>
+        z.mix_spectra(d, tbl, 0, 2);
+        size_t jte(0), jtr(0), jne(0);
+        z.load_spectra(d, tbl, jte, jtr, jne, "none", 0, false, 0, 2,
+                       em, ab, sc);
+        size_t expected = ine;
+        size_t actual = jne;
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "mix_spectra_ne_index_reseeded", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mix.inc>
+        z.mix_spectra(d, tbl, 0, 2);
+        z.set_te(z.get_te()); // next step: seeded by the previous index
+        z.mix_spectra(d, tbl, 0, 2);
+        size_t jte(0), jtr(0), jne(0);
+        z.load_spectra(d, tbl, jte, jtr, jne, "none", 0, false, 0, 2,
+                       em, ab, sc);
+        size_t expected = ine;
+        size_t actual = jne;
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "mix_spectra_reset_by_setter", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mix.inc>
+        z.mix_spectra(d, tbl, 0, 2);
+        std::string expected = "true false";
+        std::string actual = utils::bool_to_string(z.is_mixed());
+        z.set_te(z.get_te());
+        actual += " " + utils::bool_to_string(z.is_mixed());
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "load_spectra_mixture_cache", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mix.inc>
+        z.intern_mat(d, tbl);
+        size_t jte(0), jtr(0), jne(0);
+        ArrDbl em1, ab1, sc1, em2, ab2, sc2;
+        z.load_spectra(d, tbl, jte, jtr, jne, "none", 0, false, 0, 2,
+                       em1, ab1, sc1);
+        z.load_spectra(d, tbl, jte, jtr, jne, "none", 0, false, 0, 2,
+                       em2, ab2, sc2);
+        std::string expected = "1 1   2.000000e+00 true";
+        std::string actual = std::to_string(d.get_mix_size()) + " "
+                           + std::to_string(d.get_mix_hits())
+                           + utils::double_to_string(d.get_mix_dedup()) + " "
+                           + utils::bool_to_string(
+                               fabs(em2[2] - em1[2]) < spec_eqt(EQT, em1[2]) &&
+                               fabs(sc2[1] - sc1[1]) < spec_eqt(EQT, sc1[1]));
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "load_bands", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        #include <mix.inc>
+        BandSet b;
+        b.jlo = {0, 1};
+        b.jhi = {1, 2};
+        b.weight = "planck";
+        size_t ib = d.band_index(b);
+        size_t jte(0), jtr(0), jne(0);
+        ArrDbl emb, abb, scb;
+        z.load_bands(d, tbl, jte, jtr, jne, ib, 2, emb, abb, scb);
+        // emissivity: hv-average of the mixture (trapezoid, equal weights)
+        double em0 = 0.5 * (em[0] + em[1]);
+        double em1 = 0.5 * (em[1] + em[2]);
+        std::string expected = "2 5 true true";
+        std::string actual = std::to_string(emb.size()) + " "
+            + std::to_string(jne) + " "
+            + utils::bool_to_string(std::abs(emb[0] - em0) <= 1.0e-6 * em0
+                                    &&  std::abs(emb[1] - em1) <= 1.0e-6 * em1)
+            + " " + utils::bool_to_string(abb[0] > 0.0  &&  scb[1] >= 0.0);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
 }
 
 //  end test_Zone.cpp
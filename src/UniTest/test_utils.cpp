@@ -8,7 +8,7 @@ Los Alamos National Laboratory
 XCP-5 group
 
 Created on 29 November 2014
-Last modified on 2 October 2020
+Last modified on 17 October 2026
 
 Copyright (c) 2015, Triad National Security, LLC.
 All rights reserved.
@@ -257,6 +257,55 @@ const double EQT = 1.0e-15;
 
 //-----------------------------------------------------------------------------
 
+{
+    Test t(GROUP, "hash_string", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        uint64_t expected = 0xaf63dc4c8601ec8cULL; // FNV-1a of "a"
+        uint64_t actual = utils::hash_string("a");
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "hash_string_combined", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        uint64_t expected = utils::hash_string("ab");
+        uint64_t actual = utils::hash_string("b", utils::hash_string("a"));
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "hash_bytes", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        const std::vector<double> x = {1.0, -2.5};
+        uint64_t expected = utils::hash_string(
+            std::string(reinterpret_cast<const char *>(x.data()),
+                        x.size() * sizeof(double)));
+        uint64_t actual = utils::hash_bytes(x.data(), sizeof(double));
+        actual = utils::hash_bytes(x.data() + 1, sizeof(double), actual);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 {
     Test t(GROUP, "sign_int_positive", "fast");
 
@@ -3301,6 +3350,101 @@ const double EQT = 1.0e-15;
 
 //-----------------------------------------------------------------------------
 
+{
+    Test t(GROUP, "find_word_opt_found", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string fname(cnststr::PATH + "UniTest/text_file.txt");
+        std::ifstream infile(fname.c_str());
+        utils::find_word_opt(infile, "text");
+        std::string expected = "file.";
+        std::string actual;
+        infile >> actual;
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "find_word_opt_not_found", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string fname(cnststr::PATH + "UniTest/text_file.txt");
+        std::ifstream infile(fname.c_str());
+        utils::find_word(infile, "is");
+        bool found = utils::find_word_opt(infile, "absent");
+        std::string actual;
+        infile >> actual;
+        std::string expected = "false a";
+        actual = utils::bool_to_string(found) + " " + actual;
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "list_dir_dirs", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/");
+        std::vector<std::string> v = utils::list_dir(path, true);
+        std::string expected = "eos grids spectra";
+        std::string actual = v.at(0) + " " + v.at(1) + " " + v.at(2);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "list_dir_files", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Dbase3/spectra/z01/");
+        std::vector<std::string> v = utils::list_dir(path, false);
+        std::string expected = "z01_te06400ev_tr00000ev_ne5.0e16pcc_ab.txt";
+        std::string actual = v.at(0) + (v.size() == 3 ? "" : " size?");
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+{
+    Test t(GROUP, "make_dir", "fast");
+
+    t.check_to_disable_test(disabled_test_count);
+    if (t.is_enabled())
+    {
+        std::string path(cnststr::PATH + "UniTest/Output/make_dir/");
+        bool b1 = utils::make_dir(path);
+        bool b2 = utils::make_dir(path); // already exists
+        bool b3 = utils::make_dir(cnststr::PATH + "UniTest/Dbase3/grids/"
+                                  + "te_grid.txt/"); // a regular file
+        std::string expected = "1 1 0";
+        std::string actual = std::to_string(b1) + " " + std::to_string(b2)
+                           + " " + std::to_string(b3);
+
+        failed_test_count += t.check_equal(expected, actual);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 }
 
 //  end test_utils.cpp
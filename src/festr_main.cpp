@@ -4,7 +4,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 23 October 2014\n
- * Last modified on 18 August 2022
+ * Last modified on 17 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -33,6 +33,7 @@ B&R Code:  DP1516090
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <set>
 
 #ifdef MPI
 #include <mpi.h>
@@ -52,7 +53,7 @@ void print_usage()
     #ifdef _OPENMP
     std::cout << " [nthreads=1]";
     #endif
-    std::cout << std::endl;
+    std::cout << " [--check]" << std::endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -112,10 +113,13 @@ license += "POSSIBILITY OF SUCH DAMAGE.\n";
               << "\nFESTR: Finite-Element Spectral Transfer of Radiation, "
               << "Version 0.9, March 2020\n" << std::endl;
 
+    // --check: verify the Database for this run, write its catalog index
+    const bool check(argc > 2  &&  std::string(argv[argc-1]) == "--check");
+    const int nargs = check ? argc - 1 : argc;
     #ifdef _OPENMP
-    if ((argc != 2)  &&  (argc != 3))
+    if ((nargs != 2)  &&  (nargs != 3))
     #else
-    if (argc != 2)  
+    if (nargs != 2)
     #endif
     {
         print_usage();
@@ -126,7 +130,11 @@ license += "POSSIBILITY OF SUCH DAMAGE.\n";
     std::cout << "\n" << std::endl;
 
     #ifdef _OPENMP
-    if (argc == 3) glob::nthreads = atoi(argv[2]); else glob::nthreads = 1;
+    if (nargs == 3) glob::nthreads = atoi(argv[2]); else glob::nthreads = 1;
+    #endif
+
+    #ifdef MPI
+    MPI_Init(&argc, &argv); // before Database: packed data are node-shared
     #endif
 
     std::ifstream options(argv[1]);
@@ -185,9 +193,47 @@ license += "POSSIBILITY OF SUCH DAMAGE.\n";
     std::cout << "\nEOS/optical Database path: " << dbase_path << std::endl;
     bool tops_default(dbase_path == "tops_default/");
     dbase_path = top_path + dbase_path;
+    std::string dbase_format("text");
+    if (utils::find_word_opt(options, "Database_format:"))
+        options >> dbase_format;
+    std::cout << "\nEOS/optical Database format: " << dbase_format
+              << std::endl;
+    std::string dbase_pack("");
+    if (dbase_format == "packed")
+        dbase_pack = dbase_path + cnststr::DBPACK_FNAME;
+    else if (dbase_format != "text")
+    {
+        std::cerr << "Error: unknown Database_format " << dbase_format
+                  << " in festr::main" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    double cache_mb(0.0); // all Database caches, in MB; 0: unbounded
+    if (utils::find_word_opt(options, "Database_cache_MB:"))
+    {
+        options >> cache_mb;
+        std::cout << "\nDatabase cache budget: " << cache_mb
+                  << " MB" << std::endl;
+    }
     std::cout << "... loading Database ... " << std::flush;
-    Database d(tops_cmnd, dbase_path, tops_default);
+    Database d(tops_cmnd, dbase_path, tops_default, dbase_pack);
+    d.set_cache_budget(static_cast<size_t>(cache_mb * 1048576.0));
+    if (check) d.scan(); // the files, not a possibly stale catalog index
     std::cout << "done" << std::endl;
+    if (d.is_cataloged())
+        std::cout << "Database catalog: " << dbase_path
+                  << cnststr::CATALOG_FNAME << std::endl;
+    else if (!check  &&  tops_cmnd == "none"  &&  !d.is_packed()  &&
+             std::ifstream((dbase_path + cnststr::CATALOG_FNAME).c_str()))
+        std::cout << "Database catalog: " << dbase_path
+                  << cnststr::CATALOG_FNAME << " is stale (rewritten by "
+                  << "--check); Database scanned instead" << std::endl;
+    std::string prefetch("no");
+    if (utils::find_word_opt(options, "Database_prefetch:"))
+        options >> prefetch;
+    std::cout << "\nDatabase prefetch: " << prefetch;
+    if (d.is_packed()  &&  utils::string_to_bool(prefetch))
+        std::cout << " (ignored: packed Database)";
+    std::cout << std::endl;
 
     utils::find_word(options, "Diagnostics:");
     std::string diag_path;
@@ -196,6 +242,7 @@ license += "POSSIBILITY OF SUCH DAMAGE.\n";
     diag_path = top_path + diag_path;
     std::cout << "... loading Diagnostics ... " << std::flush;
     Diagnostics diag(level+1, diag_path, hydro_path, out_path, d);
+    diag.prefetch = utils::string_to_bool(prefetch);
     std::cout << "done" << std::endl;
 
     // limit the time range for postprocessing
@@ -216,11 +263,37 @@ license += "POSSIBILITY OF SUCH DAMAGE.\n";
             diag.det.at(0).get_symmetry(), tmin, tmax);
     std::cout << "done" << std::endl;
 
+    if (check)
+    {
+        std::cout << "\n... checking Database ..." << std::endl;
+        size_t nmissing = 0;
+        if (analysis)
+            std::cout << "Zone lookups are not checked in analysis mode"
+                      << std::endl;
+        else
+        {
+            std::set<SpecKey> keys(diag.lookups(d, h));
+            nmissing = d.check(keys, std::cout);
+            std::cout << keys.size() << " lookups checked, " << nmissing
+                      << " missing" << std::endl;
+        }
+        if (tops_cmnd == "none"  &&  !d.is_packed())
+        {
+            std::string fname(dbase_path + cnststr::CATALOG_FNAME);
+            std::cout << "Catalog index of " << d.write_catalog(fname)
+                      << " records written to " << fname << std::endl;
+        }
+        #ifdef MPI
+        MPI_Finalize();
+        #endif
+        return nmissing == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     std::cout << "\n... festr is running ...\n" << std::endl;
-    #ifdef MPI
-    MPI_Init(&argc, &argv);
-    #endif
     diag.execute(d, h, gol);
+    std::cout << "\n" << d.cache_to_string() << std::endl;
+    std::cout << "Ray tracing retries from Zone::zone_point: "
+              << Zone::get_nretries() << std::endl;
     #ifdef MPI
     MPI_Finalize();
     #endif
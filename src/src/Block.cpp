@@ -0,0 +1,169 @@
+/**
+ * @file Block.cpp
+ * @brief Structured Cartesian block of cells, traversed by 3-D DDA
+ * @author Peter Hakel
+ * @version 0.9
+ * @date Created on 16 October 2026\n
+ * Last modified on 16 October 2026
+ * @copyright (c) 2015, Triad National Security, LLC.
+ * All rights reserved.\n
+ * Use of this source code is governed by the BSD 3-Clause License.
+ * See top-level license.txt file for full license text.
+ */
+
+#include <Block.h>
+
+#include <utils.h>
+#include <Zone.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+//-----------------------------------------------------------------------------
+
+Block::Block(): origin(), h{0.0, 0.0, 0.0}, n{0, 0, 0} {}
+
+//-----------------------------------------------------------------------------
+
+void Block::clear()
+{
+    origin.set0();
+    for (int a = 0; a < 3; ++a)
+    {
+        h[a] = 0.0;
+        n[a] = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void Block::load(std::ifstream &geometry)
+{
+    double x, y, z;
+    utils::find_word(geometry, "origin");
+    geometry >> x >> y >> z;
+    origin = Vector3d(x, y, z);
+    utils::find_word(geometry, "spacing");
+    geometry >> h[0] >> h[1] >> h[2];
+    utils::find_word(geometry, "dims");
+    geometry >> n[0] >> n[1] >> n[2];
+    for (int a = 0; a < 3; ++a)
+        if (!(h[a] > 0.0)  ||  n[a] == 0)
+        {
+            std::cerr << "Error: Block spacing and dims must be positive "
+                      << "in Block::load" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Block::size() const
+{
+    return n[0] * n[1] * n[2];
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Block::zone_id(const size_t i, const size_t j, const size_t k) const
+{
+    return 1  +  i  +  n[0] * (j  +  n[1] * k);
+}
+
+//-----------------------------------------------------------------------------
+
+double Block::traverse(const Vector3d &p, const Vector3d &d,
+                       ChordPath &path) const
+{
+    const double o[3] = {origin.getx(), origin.gety(), origin.getz()};
+    const double q[3] = {p.getx(), p.gety(), p.getz()};
+    const double e[3] = {d.getx(), d.gety(), d.getz()};
+
+    // slab test: the Ray is within *this Block for t0 < t < t1
+    double t0 = 0.0;
+    double t1 = Vector3d::get_big();
+    for (int a = 0; a < 3; ++a)
+    {
+        const double lo = o[a];
+        const double hi = o[a]  +  h[a] * static_cast<double>(n[a]);
+        if (e[a] == 0.0)
+        {
+            if (q[a] < lo  ||  q[a] > hi) return 0.0;
+        }
+        else
+        {
+            double ta = (lo - q[a]) / e[a];
+            double tb = (hi - q[a]) / e[a];
+            if (ta > tb) std::swap(ta, tb);
+            t0 = std::max(t0, ta);
+            t1 = std::min(t1, tb);
+        }
+    }
+    if (!(t0 < t1)) return 0.0;
+    if (t0 > 0.0) path.push_back(Chord{Zone::BOUNDING_ZONE, t0}); // to Block
+
+    // cell of the entry point, and distances to the next cell boundaries
+    size_t c[3];
+    int step[3];
+    double tmax[3];
+    for (int a = 0; a < 3; ++a)
+    {
+        const double x = (q[a]  +  e[a] * t0  -  o[a]) / h[a];
+        const double last = static_cast<double>(n[a] - 1);
+        c[a] = static_cast<size_t>(std::min(std::max(floor(x), 0.0), last));
+        step[a] = (e[a] > 0.0) - (e[a] < 0.0);
+        if (step[a] == 0)
+            tmax[a] = Vector3d::get_big();
+        else // from p, not accumulated, to avoid drift along long Rays
+        {
+            const size_t b = c[a] + (step[a] > 0); // boundary index
+            tmax[a] = (o[a] + h[a] * static_cast<double>(b) - q[a]) / e[a];
+        }
+    }
+
+    double t = t0;
+    while (true)
+    {
+        int a = 0; // axis of the nearest cell boundary
+        if (tmax[1] < tmax[a]) a = 1;
+        if (tmax[2] < tmax[a]) a = 2;
+        const double tn = std::min(tmax[a], t1);
+        if (tn > t)
+        {
+            path.push_back(Chord{zone_id(c[0], c[1], c[2]), tn - t});
+            t = tn;
+        }
+        if (tn >= t1) break;
+        if (step[a] < 0  &&  c[a] == 0) break;
+        if (step[a] > 0  &&  c[a] + 1 == n[a]) break;
+        c[a] += step[a];
+        const size_t b = c[a] + (step[a] > 0);
+        tmax[a] = (o[a] + h[a] * static_cast<double>(b) - q[a]) / e[a];
+    }
+    return t;
+}
+
+//-----------------------------------------------------------------------------
+
+std::string Block::to_string() const
+{
+    std::string s("Block\norigin  " + origin.to_string() + "\nspacing");
+    for (int a = 0; a < 3; ++a) s += utils::double_to_string(h[a]);
+    s += "\ndims   ";
+    for (int a = 0; a < 3; ++a)
+        s += utils::int_to_string(n[a], ' ', cnst::INT_WIDTH);
+    return s;
+}
+
+//-----------------------------------------------------------------------------
+
+std::ostream & operator << (std::ostream &ost, const Block &o)
+{
+    ost << o.to_string();
+    return ost;
+}
+
+//-----------------------------------------------------------------------------
+
+//  end Block.cpp
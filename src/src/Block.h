@@ -0,0 +1,133 @@
+#ifndef LANL_ASC_PEM_BLOCK_H_
+#define LANL_ASC_PEM_BLOCK_H_
+
+/**
+ * @file Block.h
+ * @brief Structured Cartesian block of cells, traversed by 3-D DDA
+ * @author Peter Hakel
+ * @version 0.9
+ * @date Created on 16 October 2026\n
+ * Last modified on 16 October 2026
+ * @copyright (c) 2015, Triad National Security, LLC.
+ * All rights reserved.\n
+ * Use of this source code is governed by the BSD 3-Clause License.
+ * See top-level license.txt file for full license text.
+ */
+
+#include <Vector3d.h>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+/// Ray path element: one Zone crossing
+struct Chord
+{
+    /// ID of the crossed Zone
+    size_t zid;
+
+    /// Ray chord length (cm) across the Zone
+    double ct;
+};
+
+/// Ray path, last Zone to be crossed first (consumed from the back)
+typedef std::vector<Chord> ChordPath;
+
+//-----------------------------------------------------------------------------
+
+/** @brief Structured Cartesian block of cells
+ *
+ * A logically rectangular Mesh given by its origin (lowest corner),
+ * cell spacing, and the number of cells along x, y, z. Cell (i, j, k) is
+ * Zone 1 + i + nx * (j + ny * k) of its Mesh; Zone 0 is the bounding
+ * Sphere Zone, as for Meshes made of Faces. The cells have no Faces: Rays
+ * cross them by the Amanatides-Woo DDA in traverse(), which produces the
+ * Chord list directly.
+ * \n In a mesh_*.txt file, a Block replaces "Number_of_zones" and the list
+ * of Zones:
+ * \n Block
+ * \n origin  x y z
+ * \n spacing dx dy dz
+ * \n dims    nx ny nz
+ * \n followed by Zone 0 with its one bounding Sphere Face. The time_*.txt
+ * file lists the materials of Zones 0 through size(), as usual.
+ */
+class Block
+{
+public:
+
+    /// Default constructor
+    Block();
+
+    /// Removes all cells from *this Block
+    void clear();
+
+    /**
+     * @brief Loads origin, spacing, and dims from input file
+     * @param[in] geometry Input stream for geometry data file, after the
+     *            word "Block"
+     */
+    void load(std::ifstream &geometry);
+
+    /**
+     * @brief Getter for the number of cells
+     * @return nx * ny * nz; 0 for an empty (not loaded) Block
+     */
+    size_t size() const;
+
+    /**
+     * @brief Zone ID of a cell
+     * @param[in] i Cell index along x
+     * @param[in] j Cell index along y
+     * @param[in] k Cell index along z
+     * @return Zone ID within the Mesh
+     */
+    size_t zone_id(const size_t i, const size_t j, const size_t k) const;
+
+    /**
+     * @brief Traces a Ray through *this Block (Amanatides-Woo DDA)
+     * @param[in] p Ray starting point (outside or inside *this Block)
+     * @param[in] d Unit vector of the Ray direction
+     * @param[in,out] path Chords are appended: the Zone 0 segment from p to
+     *                the Block (if any), then the crossed cells in order
+     * @return Distance (cm) from p to the end of the last Chord, where the
+     *         Ray leaves *this Block; 0, if the Ray misses it
+     */
+    double traverse(const Vector3d &p, const Vector3d &d,
+                    ChordPath &path) const;
+
+    /**
+     * @brief String representation of a Block object
+     * @return String representation of *this
+     */
+    std::string to_string() const;
+
+
+private:
+
+    /// Lowest corner of *this Block
+    Vector3d origin;
+
+    /// Cell spacing (cm) along x, y, z
+    double h[3];
+
+    /// Number of cells along x, y, z
+    size_t n[3];
+};
+
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief Send string version of Block to an output stream
+ * @param[in,out] ost Output stream
+ * @param[in] o Block object
+ * @return Reference to output stream
+ */
+std::ostream & operator << (std::ostream &ost, const Block &o);
+
+//-----------------------------------------------------------------------------
+
+#endif  // LANL_ASC_PEM_BLOCK_H_
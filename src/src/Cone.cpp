@@ -4,7 +4,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 14 May 2015\n
- * Last modified on 28 April 2022
+ * Last modified on 16 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -21,9 +21,8 @@
 //-----------------------------------------------------------------------------
 
 // X: node index local to *this; range: 0 through size()-1
-#define NODE(X)     g.get_node(get_node((X)))
-#define POINT(X)    NODE((X)).getr()
-#define VELOCITY(X) NODE((X)).getv()
+#define POINT(X)    g.getr(get_node((X)))
+#define VELOCITY(X) g.getv(get_node((X)))
 
 //-----------------------------------------------------------------------------
 
@@ -417,7 +416,6 @@ std::pair<Vector3d, Vector3d> Cone::get_endpoints(const Grid &g,
 
 #undef VELOCITY
 #undef POINT
-#undef NODE
 
 
 //-----------------------------------------------------------------------------
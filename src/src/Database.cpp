@@ -4,7 +4,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 31 December 2014\n
- * Last modified on 6 October 2020
+ * Last modified on 17 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -15,8 +15,30 @@
 
 #include <constants.h>
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+//-----------------------------------------------------------------------------
+
+#ifdef WIN
+CacheLock::CacheLock(): mtx() {}
+CacheLock::~CacheLock() {}
+void CacheLock::lock() {mtx.lock();}
+void CacheLock::unlock() {mtx.unlock();}
+void CacheLock::lock_shared() {mtx.lock();}
+void CacheLock::unlock_shared() {mtx.unlock();}
+#else
+CacheLock::CacheLock(): rw() {pthread_rwlock_init(&rw, nullptr);}
+CacheLock::~CacheLock() {pthread_rwlock_destroy(&rw);}
+void CacheLock::lock() {pthread_rwlock_wrlock(&rw);}
+void CacheLock::unlock() {pthread_rwlock_unlock(&rw);}
+void CacheLock::lock_shared() {pthread_rwlock_rdlock(&rw);}
+void CacheLock::unlock_shared() {pthread_rwlock_unlock(&rw);}
+#endif
 
 //-----------------------------------------------------------------------------
 
@@ -74,16 +96,69 @@ void Database::read_grid_file(const std::string &fname, const int iwidth,
 
 //-----------------------------------------------------------------------------
 
-double Database::nearest_ne(const std::string &froot,  const Table &tbl,
+void Database::write_grid_slice(const std::string &src,
+                                const std::string &dst,
+                                const size_t i0, const size_t i1)
+{
+    std::ifstream infile(src.c_str());
+    if (!infile.is_open())
+    {
+        std::cerr << "Error: file " << src << " is not open in "
+                  << "Database::write_grid_slice" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    size_t nbits, n;
+    utils::find_line(infile, "Number of bits:");
+    infile >> nbits;
+    utils::find_line(infile, "Number of grid points:");
+    infile >> n;
+    if (i0 > i1  ||  i1 >= n)
+    {
+        std::cerr << "Error: range " << i0 << " " << i1 << " is outside "
+                  << "grid file " << src << " in Database::write_grid_slice"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::ofstream outfile(dst.c_str());
+    if (!outfile.is_open())
+    {
+        std::cerr << "Error: file " << dst << " is not open in "
+                  << "Database::write_grid_slice" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    outfile << "\n Number of bits:\n" << std::setw(12) << nbits << "\n"
+            << "\n Number of grid points:\n" << std::setw(12) << i1-i0+1
+            << "\n\n Grid points:";
+    utils::find_line(infile, "Grid points:");
+    for (size_t i = 0; i <= i1; ++i)
+    {   // grid values are copied as strings, keeping the file name labels
+        size_t j;
+        std::string x;
+        infile >> j >> x;
+        if (i >= i0) outfile << "\n" << std::setw(12) << i-i0 << "   " << x;
+    }
+    outfile << std::endl;
+    infile.close();
+    infile.clear();
+    outfile.close();
+    outfile.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+double Database::nearest_ne(const size_t ite, const size_t itr,
                             const double np, const unsigned short int nmat,
-                            const std::vector<std::string> &mat,
+                            const std::vector<size_t> &mid,
                             const std::vector<double> &fp, size_t &ine) const
 {
-    StoichZbar ne_diff(this, tbl, froot, np, nmat, mat, fp);
-    ine = utils::nearest_exh(0.0, ne_diff, nne);
+    StoichZbar ne_diff(this, ite, itr, np, nmat, mid, fp);
+    if (ne_diff.is_monotone()) // O(log nne) probes, seeded by incoming ine
+        ine = utils::nearest(0.0, ne_diff, nne, std::min(ine, nne-1));
+    else
+        ine = utils::nearest_exh(0.0, ne_diff, nne);
     std::vector<double> zbars;
     zbars.reserve(nmat);
-    load_zbars(froot, tbl, nmat, mat, ine, zbars);
+    load_zbars(ite, itr, nmat, mid, ine, zbars);
     return utils::ne_charge_neut(np, nmat, fp, zbars);
 }
 
@@ -96,18 +171,34 @@ Database::Database():
     nbits_neman(0), nneman(0), neman(), neman_str(),
     nbits_neexp(0), nneexp(0), neexp(), neexp_str(),
     nbits_ne(0), nne(0), ne(), ne_str(),
-    nhv(0), hv() {}
+    nhv(0), hv(), mat_index(), mat_name(), spec_cache(), cache_hits(0), cache_misses(0),
+    cache_clock(0), cache_bytes(0), cache_evictions(0), cache_budget(0),
+    mix_cache(), mix_bytes(0), mix_hits(0), mix_puts(0), band_sets(),
+    band_cache(),
+    cache_lock(), pack(), zbar_mat(), zbar(), zbar_mono(), spec_avail(),
+    cataloged(false) {}
 
 //-----------------------------------------------------------------------------
 
 Database::Database(const std::string &t, const std::string &p, const bool td):
+    Database(t, p, td, "") {}
+
+//-----------------------------------------------------------------------------
+
+Database::Database(const std::string &t, const std::string &p, const bool td,
+                   const std::string &pk):
     tops_cmnd(t), path(p), tops_default(td),
     nbits_te(0), nte(0), te(), te_str(),
     nbits_tr(0), ntr(0), tr(), tr_str(),
     nbits_neman(0), nneman(0), neman(), neman_str(),
     nbits_neexp(0), nneexp(0), neexp(), neexp_str(),
     nbits_ne(0), nne(0), ne(), ne_str(),
-    nhv(0), hv()
+    nhv(0), hv(), mat_index(), mat_name(), spec_cache(), cache_hits(0), cache_misses(0),
+    cache_clock(0), cache_bytes(0), cache_evictions(0), cache_budget(0),
+    mix_cache(), mix_bytes(0), mix_hits(0), mix_puts(0), band_sets(),
+    band_cache(),
+    cache_lock(), pack(), zbar_mat(), zbar(), zbar_mono(), spec_avail(),
+    cataloged(false)
 {
     if (t == "none")
     {
@@ -137,6 +228,205 @@ Database::Database(const std::string &t, const std::string &p, const bool td):
     size_t nbits_hv;
     std::vector<std::string> hv_str;
     read_grid_file(p + "grids/hv_grid.txt", 0, nbits_hv, nhv, hv, hv_str);
+
+    if (!pk.empty())
+    {
+        pack = std::make_shared<const DbPack>(pk);
+        if (pack->get_nte() != nte  ||  pack->get_ntr() != ntr  ||
+            pack->get_nne() != nne  ||  pack->get_nhv() != nhv)
+        {
+            std::cerr << "Error: grids of packed file " << pk << " do not "
+                      << "match those in " << p << "grids/ in "
+                      << "Database::Database" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (t == "none") load_zbar_table(true);
+}
+
+//-----------------------------------------------------------------------------
+
+void Database::load_zbar_table(const bool use_index)
+{
+    mat_index.clear();
+    mat_name.clear();
+    zbar_mat.clear();
+    zbar.clear();
+    zbar_mono.clear();
+    spec_avail.clear();
+    cataloged = false;
+    const size_t nrow = nte * ntr * nne;
+
+    if (is_packed())
+    {
+        const size_t nm = pack->get_nmat();
+        zbar.assign(nm * nrow, std::nan(""));
+        spec_avail.assign(nm * nrow, false);
+        for (size_t imat = 0; imat < nm; ++imat)
+        {
+            zbar_mat[pack->get_material(imat)] = imat;
+            double *row = zbar.data() + imat * nrow;
+            for (size_t ite = 0; ite < nte; ++ite)
+            for (size_t itr = 0; itr < ntr; ++itr)
+            for (size_t ine = 0; ine < nne; ++ine)
+            {
+                const size_t k = (ite*ntr + itr)*nne + ine;
+                const double *p = pack->get_zbar(imat, ite, itr, ine);
+                if (p != nullptr) row[k] = *p;
+                spec_avail[imat*nrow + k] =
+                    pack->get_spectra(imat, ite, itr, ine) != nullptr;
+            }
+        }
+    }
+    else if (use_index  &&  read_catalog(path + cnststr::CATALOG_FNAME))
+        cataloged = true;
+    else
+    {
+        // map grid labels back to indices, to decode the EOS file names
+        std::map<std::string, size_t> ite_of, itr_of, ine_of;
+        for (size_t i = 0; i < nte; ++i) ite_of[te_str.at(i)] = i;
+        for (size_t i = 0; i < ntr; ++i) itr_of[tr_str.at(i)] = i;
+        for (size_t i = 0; i < nne; ++i) ine_of[ne_str.at(i)] = i;
+
+        // <m>_te<te>ev_tr<tr>ev_ne<ne>pcc_<tail>: position within a row
+        // of Database::zbar; nrow, if the name does not decode
+        auto decode = [&](const std::string &f, const std::string &head,
+                          const std::string &tail) -> size_t
+        {
+            if (f.size() <= head.size() + tail.size()  ||
+                f.compare(0, head.size(), head) != 0  ||
+                f.compare(f.size()-tail.size(), tail.size(), tail))
+                return nrow;
+            size_t k1 = f.find("ev_tr", head.size());
+            size_t k2 = f.find("ev_ne", head.size());
+            if (k1 == std::string::npos  ||  k2 == std::string::npos  ||
+                k2 < k1)
+                return nrow;
+            const size_t k3 = f.size() - tail.size();
+            auto jte = ite_of.find(f.substr(head.size(), k1 - head.size()));
+            auto jtr = itr_of.find(f.substr(k1 + 5, k2 - k1 - 5));
+            auto jne = ine_of.find(f.substr(k2 + 5, k3 - k2 - 5));
+            if (jte == ite_of.end()  ||  jtr == itr_of.end()  ||
+                jne == ine_of.end())
+                return nrow;
+            return (jte->second*ntr + jtr->second)*nne + jne->second;
+        };
+
+        const std::string dirpath(path + "eos/");
+        const std::vector<std::string> m(utils::list_dir(dirpath, true));
+        zbar.assign(m.size() * nrow, std::nan(""));
+        spec_avail.assign(m.size() * nrow, false);
+        for (size_t imat = 0; imat < m.size(); ++imat)
+        {
+            zbar_mat[m[imat]] = imat;
+            double *row = zbar.data() + imat * nrow;
+            const std::string head(m[imat] + "_te");
+            for (auto &f : utils::list_dir(dirpath + m[imat] + "/", false))
+            {
+                const size_t k = decode(f, head, "pcc_zb.txt");
+                if (k == nrow) continue;
+
+                std::string fname(dirpath + m[imat] + "/" + f);
+                std::ifstream infile(fname.c_str());
+                if (!infile.is_open())
+                {
+                    std::cerr << "Error: file " << fname << " is not open "
+                              << "in Database::load_zbar_table" << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                utils::find_word(infile, "zbar");
+                double z;
+                infile >> z;
+                row[k] = z;
+                infile.close();
+                infile.clear();
+            }
+
+            // em.txt stands for the em, ab, sc triplet
+            const std::string sdir(path + "spectra/" + m[imat] + "/");
+            for (auto &f : utils::list_dir(sdir, false))
+            {
+                const size_t k = decode(f, head, "pcc_em.txt");
+                if (k != nrow) spec_avail[imat*nrow + k] = true;
+            }
+        }
+    }
+
+    // a complete row with zbar non-increasing in ne keeps the residual
+    // ne - np * sum(fp * zbar) strictly increasing for any mixture
+    const size_t nmrow = zbar.size() / (nne > 0 ? nne : 1);
+    zbar_mono.assign(nmrow, false);
+    for (size_t k = 0; k < nmrow; ++k)
+    {
+        const double *row = zbar.data() + k * nne;
+        bool mono = !std::isnan(row[0]);
+        for (size_t ine = 1; mono  &&  ine < nne; ++ine)
+            mono = !std::isnan(row[ine])  &&  row[ine] <= row[ine-1];
+        zbar_mono[k] = mono;
+    }
+
+    // materials with EOS data are labeled by their zbar rows
+    mat_name.resize(zbar_mat.size());
+    for (auto &z : zbar_mat)
+    {
+        mat_index[z.first] = z.second;
+        mat_name[z.second] = z.first;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool Database::read_catalog(const std::string &fname)
+{
+    std::ifstream infile(fname.c_str());
+    if (!infile.is_open()) return false;
+    std::string word;
+    size_t nte_in(0), ntr_in(0), nne_in(0), nmat(0);
+    infile >> word >> nte_in >> ntr_in >> nne_in >> nmat;
+    if (!infile  ||  word != "FESTR_catalog"  ||
+        nte_in != nte  ||  ntr_in != ntr  ||  nne_in != nne)
+        return false;
+
+    // stale, if files were added to or removed from eos/ or spectra/
+    size_t nstamp(0);
+    infile >> word >> nstamp;
+    if (!infile  ||  word != "stamp") return false;
+    std::string stamp("");
+    for (size_t i = 0; i < nstamp; ++i)
+    {
+        size_t nfiles(0);
+        infile >> word >> nfiles;
+        stamp += word + " " + std::to_string(nfiles) + "\n";
+    }
+    if (!infile  ||  stamp != catalog_stamp()) return false;
+
+    const size_t nrow = nte * ntr * nne;
+    zbar.assign(nmat * nrow, std::nan(""));
+    spec_avail.assign(nmat * nrow, false);
+    for (size_t imat = 0; imat < nmat; ++imat)
+    {
+        size_t n(0);
+        infile >> word >> n;
+        zbar_mat[word] = imat;
+        for (size_t i = 0; i < n; ++i)
+        {   // flags: 1 = zbar present, 2 = spectra present
+            size_t ite(0), itr(0), ine(0), flags(0);
+            double z(0.0);
+            infile >> ite >> itr >> ine >> flags >> z;
+            if (!infile  ||  ite >= nte  ||  itr >= ntr  ||  ine >= nne)
+            {
+                std::cerr << "Error: file " << fname << " is corrupt "
+                          << "in Database::read_catalog" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            const size_t k = imat*nrow + (ite*ntr + itr)*nne + ine;
+            if (flags & 1) zbar[k] = z;
+            spec_avail[k] = (flags & 2) != 0;
+        }
+    }
+    infile.close();
+    return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -162,6 +452,259 @@ bool Database::get_tops_default() const
 
 //-----------------------------------------------------------------------------
 
+bool Database::is_packed() const
+{
+    return pack != nullptr;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::write_pack(const std::string &fname) const
+{
+    // materials are the subdirectories of eos/ and spectra/
+    std::vector<std::string> m(utils::list_dir(path + "eos/", true));
+    for (auto &s : utils::list_dir(path + "spectra/", true))
+        if (std::find(m.begin(), m.end(), s) == m.end()) m.push_back(s);
+    std::sort(m.begin(), m.end());
+
+    // loop order matches the (mat, ite, itr, ine) ordering of DbPack records
+    std::vector<DbPackEntry> entry;
+    std::vector<double> data;
+    std::vector<double> v(nhv);
+    for (size_t imat = 0; imat < m.size(); ++imat)
+    for (size_t ite = 0; ite < nte; ++ite)
+    for (size_t itr = 0; itr < ntr; ++itr)
+    for (size_t ine = 0; ine < nne; ++ine)
+    {
+        DbPackEntry e;
+        e.mat = imat;
+        e.ite = ite;
+        e.itr = itr;
+        e.ine = ine;
+        e.zb = DbPack::NONE;
+        e.sp = DbPack::NONE;
+        const std::string froot(utils::fname_root(m[imat],
+            get_te_str_at(ite), get_tr_str_at(itr), get_ne_str_at(ine)));
+
+        std::ifstream zbfile((path + "eos/" + m[imat] + "/" + froot
+                              + "zb.txt").c_str());
+        if (zbfile.is_open())
+        {
+            utils::find_word(zbfile, "zbar");
+            double zbar;
+            zbfile >> zbar;
+            e.zb = data.size();
+            data.push_back(zbar);
+            zbfile.close();
+        }
+
+        const std::string sroot(path + "spectra/" + m[imat] + "/" + froot);
+        std::ifstream emfile((sroot + "em.txt").c_str());
+        if (emfile.is_open())
+        {
+            emfile.close();
+            e.sp = data.size();
+            utils::load_array(sroot + "em.txt", nhv, 0, nhv-1, v);
+            data.insert(data.end(), v.begin(), v.end());
+            utils::load_array(sroot + "ab.txt", nhv, 0, nhv-1, v);
+            data.insert(data.end(), v.begin(), v.end());
+            utils::load_array(sroot + "sc.txt", nhv, 0, nhv-1, v);
+            data.insert(data.end(), v.begin(), v.end());
+        }
+
+        if (e.zb != DbPack::NONE  ||  e.sp != DbPack::NONE)
+            entry.push_back(e);
+    }
+
+    DbPack::write(fname, nte, ntr, nne, nhv, m, entry, data);
+    return entry.size();
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::write_subset(const std::string &dest,
+                              const DbSubset &s) const
+{
+    if (tops_cmnd != "none"  ||  is_packed()  ||  s.empty()  ||
+        s.ite1 >= nte  ||  s.itr1 >= ntr  ||  s.ine1 >= nne  ||
+        s.jmin > s.jmax  ||  s.jmax >= nhv)
+    {
+        std::cerr << "Error: no text Database subset can be written from "
+                  << path << " to " << dest << " in Database::write_subset"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    for (auto &d : {"", "grids/", "eos/", "spectra/"})
+        utils::make_dir(dest + d);
+
+    write_grid_slice(path + "grids/te_grid.txt", dest + "grids/te_grid.txt",
+                     s.ite0, s.ite1);
+    write_grid_slice(path + "grids/tr_grid.txt", dest + "grids/tr_grid.txt",
+                     s.itr0, s.itr1);
+    write_grid_slice(path + "grids/ne_man_grid.txt",
+                     dest + "grids/ne_man_grid.txt", 0, nneman-1);
+    write_grid_slice(path + "grids/ne_exp_grid.txt",
+                     dest + "grids/ne_exp_grid.txt", 0, nneexp-1);
+    write_grid_slice(path + "grids/hv_grid.txt", dest + "grids/hv_grid.txt",
+                     s.jmin, s.jmax);
+
+    size_t nfiles = 0;
+    for (auto &m : s.mat)
+    {
+        utils::make_dir(dest + "eos/" + m + "/");
+        utils::make_dir(dest + "spectra/" + m + "/");
+        for (size_t ite = s.ite0; ite <= s.ite1; ++ite)
+        for (size_t itr = s.itr0; itr <= s.itr1; ++itr)
+        for (size_t ine = 0; ine < nne; ++ine)
+        {
+            const std::string froot(m + "/" + utils::fname_root(m,
+                get_te_str_at(ite), get_tr_str_at(itr), get_ne_str_at(ine)));
+
+            // EOS: the whole file, on the full ne grid
+            std::ifstream zbfile((path + "eos/" + froot + "zb.txt").c_str());
+            if (zbfile.is_open())
+            {
+                std::ofstream outfile((dest + "eos/" + froot
+                                       + "zb.txt").c_str());
+                outfile << zbfile.rdbuf();
+                outfile.close();
+                zbfile.close();
+                ++nfiles;
+            }
+
+            // spectra: header with the new hv range, then the hv slice
+            if (ine < s.ine0  ||  ine > s.ine1) continue;
+            for (auto &q : {"em.txt", "ab.txt", "sc.txt"})
+            {
+                std::ifstream infile((path + "spectra/" + froot
+                                      + q).c_str());
+                if (!infile.is_open()) continue;
+                std::ofstream outfile((dest + "spectra/" + froot
+                                       + q).c_str());
+                std::string line;
+                while (getline(infile, line))
+                {
+                    std::string w(utils::trim(line));
+                    if (w.compare(0, 6, "hv_min") == 0)
+                        outfile << "hv_min  " << hv.at(s.jmin) << "\n";
+                    else if (w.compare(0, 6, "hv_max") == 0)
+                        outfile << "hv_max  " << hv.at(s.jmax) << "\n";
+                    else if (w.compare(0, 3, "nhv") == 0)
+                        outfile << "nhv     " << s.jmax-s.jmin+1 << "\n";
+                    else
+                        outfile << line << "\n";
+                    if (w.compare(0, 4, "data") == 0) break;
+                }
+                std::string x;
+                for (size_t j = 0; j <= s.jmax  &&  infile >> x; ++j)
+                    if (j >= s.jmin) outfile << x << "\n";
+                outfile.close();
+                infile.close();
+                ++nfiles;
+            }
+        }
+    }
+    return nfiles;
+}
+
+//-----------------------------------------------------------------------------
+
+void Database::scan()
+{
+    if (tops_cmnd == "none") load_zbar_table(false);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::write_catalog(const std::string &fname) const
+{
+    std::ofstream outfile(fname.c_str());
+    if (!outfile.is_open())
+    {
+        std::cerr << "Error: file " << fname << " is not open in "
+                  << "Database::write_catalog" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    outfile << std::setprecision(std::numeric_limits<double>::max_digits10);
+    const size_t nrow = nte * ntr * nne;
+    std::vector<std::string> m(zbar_mat.size());
+    for (auto &z : zbar_mat) m[z.second] = z.first;
+    outfile << "FESTR_catalog " << nte << " " << ntr << " " << nne << " "
+            << m.size() << "\n";
+    const std::string stamp(catalog_stamp());
+    outfile << "stamp " << std::count(stamp.begin(), stamp.end(), '\n')
+            << "\n" << stamp;
+    size_t nrec = 0;
+    for (size_t imat = 0; imat < m.size(); ++imat)
+    {
+        std::ostringstream rec;
+        size_t n = 0;
+        for (size_t k = 0; k < nrow; ++k)
+        {
+            const size_t i = imat*nrow + k;
+            const size_t flags = (std::isnan(zbar[i]) ? 0 : 1)
+                               + (spec_avail[i] ? 2 : 0);
+            if (flags == 0) continue;
+            rec << k/(ntr*nne) << " " << (k/nne) % ntr << " " << k % nne
+                << " " << flags << " " << (flags & 1 ? zbar[i] : 0.0) << "\n";
+            ++n;
+        }
+        outfile << m[imat] << " " << n << "\n" << rec.str();
+        nrec += n;
+    }
+    outfile.close();
+    return nrec;
+}
+
+//-----------------------------------------------------------------------------
+
+std::string Database::catalog_stamp() const
+{
+    std::string s("");
+    for (auto &d : {"eos/", "spectra/"})
+        for (auto &m : utils::list_dir(path + d, true))
+            s += d + m + " "
+               + std::to_string(utils::list_dir(path + d + m + "/",
+                                                false).size()) + "\n";
+    return s;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Database::is_cataloged() const
+{
+    return cataloged;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Database::has_spectra(const size_t imat, const size_t ite,
+                           const size_t itr, const size_t ine) const
+{
+    const size_t nrow = nte * ntr * nne;
+    const size_t i = imat*nrow + (ite*ntr + itr)*nne + ine;
+    return i < spec_avail.size()  &&  spec_avail[i];
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::check(const std::set<SpecKey> &keys, std::ostream &ost) const
+{
+    size_t nmissing = 0;
+    for (auto &k : keys)
+    {
+        if (has_spectra(k.mat, k.ite, k.itr, k.ine)) continue;
+        ost << "Missing: spectra of " << material_name(k.mat)
+            << " at te = " << get_te_str_at(k.ite)
+            << ", tr = " << get_tr_str_at(k.itr)
+            << ", ne = " << get_ne_str_at(k.ine) << std::endl;
+        ++nmissing;
+    }
+    return nmissing;
+}
+
+//-----------------------------------------------------------------------------
+
 size_t Database::get_nbits_te() const
 {
     return nbits_te;
@@ -344,30 +887,640 @@ std::string Database::to_string() const
 
 //-----------------------------------------------------------------------------
 
-void Database::load_zbars(const std::string &froot, const Table &tbl,
+std::string Database::material_name(const size_t imat) const
+{
+    SharedGuard guard(cache_lock);
+    return mat_name.at(imat);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::material_index(const std::string &m) const
+{
+    {
+        SharedGuard guard(cache_lock);
+        auto it = mat_index.find(m);
+        if (it != mat_index.end()) return it->second;
+    }
+    std::lock_guard<CacheLock> guard(cache_lock); // new material
+    auto it = mat_index.find(m);
+    if (it != mat_index.end()) return it->second;
+    size_t i = mat_name.size();
+    mat_index.insert(std::make_pair(m, i));
+    mat_name.push_back(m);
+    return i;
+}
+
+//-----------------------------------------------------------------------------
+
+std::vector<size_t> Database::material_index(const Table &tbl,
+                                const unsigned short int nmat,
+                                const std::vector<std::string> &mat) const
+{
+    std::vector<size_t> mid(nmat);
+    for (unsigned short int i = 0; i < nmat; ++i)
+        mid[i] = material_index(tbl.get_F(mat.at(i)));
+    return mid;
+}
+
+//-----------------------------------------------------------------------------
+
+void Database::get_spectra(const std::string &m, const size_t ite,
+                           const size_t itr, const size_t ine,
+                           const size_t jmin, const size_t jmax,
+                           ArrDbl &em, ArrDbl &ab, ArrDbl &sc) const
+{
+    get_spectra(material_index(m), ite, itr, ine, jmin, jmax, em, ab, sc);
+}
+
+//-----------------------------------------------------------------------------
+
+void Database::get_spectra(const size_t imat, const size_t ite,
+                           const size_t itr, const size_t ine,
+                           const size_t jmin, const size_t jmax,
+                           ArrDbl &em, ArrDbl &ab, ArrDbl &sc) const
+{
+    const size_t n = jmax - jmin + 1;
+    em.assign(n, 0.0);
+    ab.assign(n, 0.0);
+    sc.assign(n, 0.0);
+
+    if (is_packed()) // no parsing and no caching: the OS pages the file in
+    {
+        // materials of the packed file are labeled by their positions in it
+        const double *p = imat < pack->get_nmat() ?
+                          pack->get_spectra(imat, ite, itr, ine) : nullptr;
+        if (p == nullptr)
+        {
+            std::cerr << "Error: spectra of " << material_name(imat)
+                      << " at te = "
+                      << get_te_str_at(ite) << ", tr = " << get_tr_str_at(itr)
+                      << ", ne = " << get_ne_str_at(ine) << " are not in "
+                      << pack->get_fname() << " in Database::get_spectra"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        for (size_t j = 0; j < n; ++j)
+        {
+            em[j] = p[jmin+j];
+            ab[j] = p[nhv+jmin+j];
+            sc[j] = p[2*nhv+jmin+j];
+        }
+        return;
+    }
+
+    const SpecKey key(imat, ite, itr, ine);
+
+    // the lock is held only for map access, not for reading files; hits
+    // share it and only stamp their entry, so that threads read in parallel
+    size_t jlo = jmin;
+    size_t jhi = jmax;
+    std::string m;
+    {
+        SharedGuard guard(cache_lock);
+        auto it = spec_cache.find(key);
+        if (it != spec_cache.end())
+        {
+            const SpecData &c = it->second;
+            if (c.jmin <= jmin  &&  jmax <= c.jmax)
+            {
+                const size_t k = jmin - c.jmin;
+                for (size_t j = 0; j < n; ++j)
+                {
+                    em[j] = c.em[k+j];
+                    ab[j] = c.ab[k+j];
+                    sc[j] = c.sc[k+j];
+                }
+                c.used.store(++cache_clock, std::memory_order_relaxed);
+                ++cache_hits;
+                return;
+            }
+            // cached range is too narrow: reload the union of both ranges
+            if (c.jmin < jlo) jlo = c.jmin;
+            if (c.jmax > jhi) jhi = c.jmax;
+        }
+        ++cache_misses;
+        m = mat_name.at(imat); // file names are built on a miss only
+    }
+    if (!has_spectra(imat, ite, itr, ine))
+    {
+        std::cerr << "Error: spectra of " << m << " at te = "
+                  << get_te_str_at(ite) << ", tr = " << get_tr_str_at(itr)
+                  << ", ne = " << get_ne_str_at(ine) << " are not in "
+                  << path << (cataloged ? cnststr::CATALOG_FNAME : "")
+                  << " (festr --check lists all missing data) "
+                  << "in Database::get_spectra" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    SpecData s;
+    s.jmin = jlo;
+    s.jmax = jhi;
+    const size_t ns = jhi - jlo + 1;
+    s.em.assign(ns, 0.0);
+    s.ab.assign(ns, 0.0);
+    s.sc.assign(ns, 0.0);
+    const std::string froot(path + "spectra/" + m + "/"
+                            + utils::fname_root(m, get_te_str_at(ite),
+                                                get_tr_str_at(itr),
+                                                get_ne_str_at(ine)));
+    utils::load_array(froot + "em.txt", nhv, jlo, jhi, s.em);
+    utils::load_array(froot + "ab.txt", nhv, jlo, jhi, s.ab);
+    utils::load_array(froot + "sc.txt", nhv, jlo, jhi, s.sc);
+
+    const size_t k = jmin - jlo;
+    for (size_t j = 0; j < n; ++j)
+    {
+        em[j] = s.em[k+j];
+        ab[j] = s.ab[k+j];
+        sc[j] = s.sc[k+j];
+    }
+
+    std::lock_guard<CacheLock> guard(cache_lock);
+    auto it = spec_cache.find(key);
+    if (it != spec_cache.end()) // replaced: a wider range, or another thread
+    {
+        cache_bytes -= it->second.bytes();
+        spec_cache.erase(it);
+    }
+    cache_bytes += s.bytes();
+    const size_t stamp = ++cache_clock;
+    s.used = stamp;
+    spec_cache.insert(std::make_pair(key, std::move(s)));
+    if (cache_budget > 0  &&  cache_bytes + mix_bytes > cache_budget)
+        evict(stamp);
+}
+
+//-----------------------------------------------------------------------------
+
+void Database::evict(const size_t keep) const
+{   // least recently used first; one sort per overflow, not one per entry
+    std::vector<std::map<SpecKey, SpecData>::iterator> sit;
+    std::vector<std::map<MixKey, MixData>::iterator> mit;
+    std::vector<std::map<std::pair<size_t, SpecKey>, MixData>::iterator> bit;
+    std::vector<std::tuple<size_t, int, size_t>> age; // used, cache, index
+    age.reserve(spec_cache.size() + mix_cache.size() + band_cache.size());
+    for (auto it = spec_cache.begin(); it != spec_cache.end(); ++it)
+        if (it->second.used.load() != keep)
+        {
+            age.emplace_back(it->second.used.load(), 0, sit.size());
+            sit.push_back(it);
+        }
+    for (auto it = mix_cache.begin(); it != mix_cache.end(); ++it)
+        if (it->second.used.load() != keep)
+        {
+            age.emplace_back(it->second.used.load(), 1, mit.size());
+            mit.push_back(it);
+        }
+    for (auto it = band_cache.begin(); it != band_cache.end(); ++it)
+        if (it->second.used.load() != keep)
+        {
+            age.emplace_back(it->second.used.load(), 2, bit.size());
+            bit.push_back(it);
+        }
+    std::sort(age.begin(), age.end());
+    for (auto &a : age)
+    {
+        if (cache_bytes + mix_bytes <= cache_budget) break;
+        const size_t i = std::get<2>(a);
+        switch (std::get<1>(a))
+        {
+            case 0:
+                cache_bytes -= sit[i]->second.bytes();
+                spec_cache.erase(sit[i]);
+                break;
+            case 1:
+                mix_bytes -= mit[i]->second.bytes();
+                mix_cache.erase(mit[i]);
+                break;
+            default:
+                cache_bytes -= bit[i]->second.bytes();
+                band_cache.erase(bit[i]);
+        }
+        ++cache_evictions;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::get_cache_hits() const
+{
+    return cache_hits;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::get_cache_misses() const
+{
+    return cache_misses;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::get_cache_size() const
+{
+    SharedGuard guard(cache_lock);
+    return spec_cache.size();
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::get_cache_evictions() const
+{
+    SharedGuard guard(cache_lock);
+    return cache_evictions;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::get_cache_bytes() const
+{
+    SharedGuard guard(cache_lock);
+    return cache_bytes;
+}
+
+//-----------------------------------------------------------------------------
+
+void Database::set_cache_budget(const size_t b)
+{
+    std::lock_guard<CacheLock> guard(cache_lock);
+    cache_budget = b;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::get_cache_budget() const
+{
+    return cache_budget;
+}
+
+//-----------------------------------------------------------------------------
+
+std::string Database::cache_to_string() const
+{
+    std::string s("");
+    if (is_packed())
+        s = (pack->is_shared() ? "Spectral data shared on node from "
+                               : "Spectral data mapped from ")
+          + pack->get_fname();
+    else
+    {
+        s += "Spectral cache entries:";
+        s += utils::int_to_string(get_cache_size(), ' ', cnst::INT_WIDTH)
+           + "\n";
+        s += "Spectral cache hits:   ";
+        s += utils::int_to_string(get_cache_hits(), ' ', cnst::INT_WIDTH)
+           + "\n";
+        s += "Spectral cache misses: ";
+        s += utils::int_to_string(get_cache_misses(), ' ', cnst::INT_WIDTH)
+           + "\n";
+        s += "Spectral cache evicted:";
+        s += utils::int_to_string(get_cache_evictions(), ' ', cnst::INT_WIDTH)
+           + "\n";
+        s += "Spectral cache bytes:  ";
+        s += utils::int_to_string(get_cache_bytes(), ' ', cnst::INT_WIDTH);
+        if (get_cache_budget() > 0)
+            s += " of"
+               + utils::int_to_string(get_cache_budget(), ' ', cnst::INT_WIDTH);
+    }
+    s += "\nMixture cache entries:";
+    s += utils::int_to_string(get_mix_size(), ' ', cnst::INT_WIDTH) + "\n";
+    s += "Mixture cache hits:   ";
+    s += utils::int_to_string(get_mix_hits(), ' ', cnst::INT_WIDTH) + "\n";
+    s += "Mixture dedup ratio:  " + utils::double_to_string(get_mix_dedup());
+    if (get_band_size() > 0)
+        s += "\nBand-averaged entries:"
+           + utils::int_to_string(get_band_size(), ' ', cnst::INT_WIDTH);
+    return s;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Database::get_mixture(const MixKey &key,
+                           ArrDbl &em, ArrDbl &ab, ArrDbl &sc) const
+{
+    SharedGuard guard(cache_lock);
+    auto it = mix_cache.find(key);
+    if (it == mix_cache.end()) return false;
+    const MixData &c = it->second;
+    c.used.store(++cache_clock, std::memory_order_relaxed);
+    const size_t n = c.em.size();
+    em.assign(n, 0.0);
+    ab.assign(n, 0.0);
+    sc.assign(n, 0.0);
+    for (size_t j = 0; j < n; ++j)
+    {
+        em[j] = c.em[j];
+        ab[j] = c.ab[j];
+        sc[j] = c.sc[j];
+    }
+    ++mix_hits;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void Database::put_mixture(const MixKey &key, const ArrDbl &em,
+                           const ArrDbl &ab, const ArrDbl &sc) const
+{
+    MixData c;
+    const size_t n = em.size();
+    c.em.resize(n);
+    c.ab.resize(n);
+    c.sc.resize(n);
+    for (size_t j = 0; j < n; ++j)
+    {
+        c.em[j] = static_cast<SpecReal>(em[j]);
+        c.ab[j] = static_cast<SpecReal>(ab[j]);
+        c.sc[j] = static_cast<SpecReal>(sc[j]);
+    }
+
+    std::lock_guard<CacheLock> guard(cache_lock);
+    ++mix_puts;
+    const size_t nb = c.bytes();
+    const size_t stamp = ++cache_clock;
+    c.used = stamp;
+    auto ins = mix_cache.insert(std::make_pair(key, std::move(c)));
+    if (!ins.second) return; // stored by another thread
+    mix_bytes += nb;
+    if (cache_budget > 0  &&  cache_bytes + mix_bytes > cache_budget)
+        evict(stamp);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::get_mix_size() const
+{
+    SharedGuard guard(cache_lock);
+    return mix_cache.size();
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::get_mix_hits() const
+{
+    return mix_hits;
+}
+
+//-----------------------------------------------------------------------------
+
+double Database::get_mix_dedup() const
+{
+    SharedGuard guard(cache_lock);
+    if (mix_puts == 0) return 1.0;
+    return static_cast<double>(mix_hits + mix_puts)
+         / static_cast<double>(mix_puts);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::band_index(const BandSet &b) const
+{
+    if (b.size() == 0  ||  b.jhi.size() != b.size()  ||
+        (b.weight != "planck"  &&  b.weight != "rosseland"))
+    {
+        std::cerr << "Error: bad BandSet (" << b.size() << " bands, weight "
+                  << b.weight << ") in Database::band_index" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    for (size_t k = 0; k < b.size(); ++k)
+        if (b.jlo.at(k) > b.jhi.at(k)  ||  b.jhi.at(k) >= nhv)
+        {
+            std::cerr << "Error: band " << k << " [" << b.jlo.at(k) << ", "
+                      << b.jhi.at(k) << "] is outside of the hv grid in "
+                      << "Database::band_index" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+    std::lock_guard<CacheLock> guard(cache_lock);
+    for (size_t ib = 0; ib < band_sets.size(); ++ib)
+        if (!(band_sets[ib] < b)  &&  !(b < band_sets[ib])) return ib;
+    band_sets.push_back(b);
+    return band_sets.size() - 1;
+}
+
+//-----------------------------------------------------------------------------
+
+void Database::get_bands(const size_t imat, const size_t ite,
+                         const size_t itr, const size_t ine, const size_t ib,
+                         ArrDbl &em, ArrDbl &ab, ArrDbl &sc) const
+{
+    const std::pair<size_t, SpecKey> key(ib, SpecKey(imat, ite, itr, ine));
+    BandSet b;
+    {
+        SharedGuard guard(cache_lock);
+        if (ib >= band_sets.size())
+        {
+            std::cerr << "Error: BandSet " << ib << " is not registered in "
+                      << "Database::get_bands" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        auto it = band_cache.find(key);
+        if (it != band_cache.end())
+        {
+            const MixData &c = it->second;
+            c.used.store(++cache_clock, std::memory_order_relaxed);
+            const size_t n = c.em.size();
+            em.assign(n, 0.0);
+            ab.assign(n, 0.0);
+            sc.assign(n, 0.0);
+            for (size_t k = 0; k < n; ++k)
+            {
+                em[k] = c.em[k];
+                ab[k] = c.ab[k];
+                sc[k] = c.sc[k];
+            }
+            return;
+        }
+        b = band_sets[ib];
+    }
+
+    const size_t nb = b.size();
+    const size_t jmin = *std::min_element(b.jlo.begin(), b.jlo.end());
+    const size_t jmax = *std::max_element(b.jhi.begin(), b.jhi.end());
+    ArrDbl vem, vab, vsc;
+    get_spectra(imat, ite, itr, ine, jmin, jmax, vem, vab, vsc);
+    const double tev = get_te_at(ite);
+
+    MixData c;
+    c.em.resize(nb);
+    c.ab.resize(nb);
+    c.sc.resize(nb);
+    for (size_t k = 0; k < nb; ++k)
+    {
+        std::vector<double> w = band_weights(hv, b.jlo[k], b.jhi[k]);
+        const size_t nw = w.size();
+        const size_t j0 = b.jlo[k] - jmin;
+        double sw(0.0), sem(0.0), swp(0.0), sab(0.0), ssc(0.0);
+        std::vector<double> wp(nw, 0.0); // Planck or Rosseland weights
+        for (size_t i = 0; i < nw; ++i)
+        {
+            const double x = hv[b.jlo[k]+i] / tev;
+            const double bb = utils::planckian(hv[b.jlo[k]+i], tev);
+            if (b.weight == "rosseland"  &&  bb > 0.0)
+                wp[i] = w[i] * bb * x / (-std::expm1(-x)); // dB/dte * te
+            else
+                wp[i] = w[i] * bb;
+            sw += w[i];
+            sem += w[i] * vem[j0+i];
+            swp += wp[i];
+        }
+        if (!(swp > 0.0)  ||  !std::isfinite(swp)) // cold: hv-average
+        {
+            wp = w;
+            swp = sw;
+        }
+        for (size_t i = 0; i < nw; ++i)
+        {
+            sab += wp[i] * vab[j0+i];
+            ssc += wp[i] * vsc[j0+i];
+        }
+        double mab(sab / swp), msc(ssc / swp);
+        if (b.weight == "rosseland")
+        {   // harmonic mean of the total opacity, 0 if it has a gap
+            double sinv(0.0);
+            bool gap(false);
+            for (size_t i = 0; i < nw; ++i)
+            {
+                const double op = vab[j0+i] + vsc[j0+i];
+                if (op > 0.0)
+                    sinv += wp[i] / op;
+                else if (wp[i] > 0.0)
+                    gap = true;
+            }
+            const double opr = (gap  ||  !(sinv > 0.0)) ? 0.0 : swp / sinv;
+            const double opp = mab + msc;
+            mab = opp > 0.0 ? opr * mab / opp : 0.0;
+            msc = opp > 0.0 ? opr - mab : 0.0;
+        }
+        c.em[k] = static_cast<SpecReal>(sem / sw);
+        c.ab[k] = static_cast<SpecReal>(mab);
+        c.sc[k] = static_cast<SpecReal>(msc);
+    }
+
+    em.assign(nb, 0.0);
+    ab.assign(nb, 0.0);
+    sc.assign(nb, 0.0);
+    for (size_t k = 0; k < nb; ++k)
+    {
+        em[k] = c.em[k];
+        ab[k] = c.ab[k];
+        sc[k] = c.sc[k];
+    }
+    std::lock_guard<CacheLock> guard(cache_lock);
+    const size_t nbytes = c.bytes();
+    const size_t stamp = ++cache_clock;
+    c.used = stamp;
+    if (!band_cache.insert(std::make_pair(key, std::move(c))).second)
+        return; // stored by another thread
+    cache_bytes += nbytes;
+    if (cache_budget > 0  &&  cache_bytes + mix_bytes > cache_budget)
+        evict(stamp);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::get_band_size() const
+{
+    SharedGuard guard(cache_lock);
+    return band_cache.size();
+}
+
+//-----------------------------------------------------------------------------
+
+std::vector<double> Database::band_weights(const std::vector<double> &x,
+                                           const size_t klo, const size_t khi)
+{
+    std::vector<double> w(khi - klo + 1, 1.0);
+    if (khi == klo) return w;
+    for (size_t k = klo; k <= khi; ++k)
+    {
+        const double xl = x.at(k > klo ? k-1 : k);
+        const double xh = x.at(k < khi ? k+1 : k);
+        w.at(k - klo) = 0.5 * (xh - xl);
+    }
+    return w;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Database::get_nzbar_mat() const
+{
+    return zbar_mat.size();
+}
+
+//-----------------------------------------------------------------------------
+
+const double * Database::zbar_row(const std::string &m,
+                                  const size_t ite, const size_t itr) const
+{
+    return zbar_row(material_index(m), ite, itr);
+}
+
+//-----------------------------------------------------------------------------
+
+const double * Database::zbar_row(const size_t imat,
+                                  const size_t ite, const size_t itr) const
+{
+    if (imat >= zbar_mat.size())
+    {
+        std::cerr << "Error: material " << material_name(imat) << " has no "
+                  << "EOS data in " << path << " in Database::zbar_row"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return zbar.data() + ((imat*nte + ite)*ntr + itr)*nne;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Database::zbar_row_monotone(const std::string &m,
+                                 const size_t ite, const size_t itr) const
+{
+    return zbar_row_monotone(material_index(m), ite, itr);
+}
+
+//-----------------------------------------------------------------------------
+
+bool Database::zbar_row_monotone(const size_t imat,
+                                 const size_t ite, const size_t itr) const
+{
+    const size_t k = static_cast<size_t>(zbar_row(imat, ite, itr)
+                                         - zbar.data());
+    return zbar_mono.at(k / nne);
+}
+
+//-----------------------------------------------------------------------------
+
+void Database::load_zbars(const size_t ite, const size_t itr,
+                          const Table &tbl,
                           const unsigned short int nmat,
                           const std::vector<std::string> &mat,
                           const size_t ine, std::vector<double> &zb) const
 {
-    const std::string dirpath(path + "eos/");
-    const std::string allparam(froot + get_ne_str_at(ine) + "pcc_zb.txt");
+    load_zbars(ite, itr, nmat, material_index(tbl, nmat, mat), ine, zb);
+}
+
+//-----------------------------------------------------------------------------
+
+void Database::load_zbars(const size_t ite, const size_t itr,
+                          const unsigned short int nmat,
+                          const std::vector<size_t> &mid,
+                          const size_t ine, std::vector<double> &zb) const
+{
     for (unsigned short int i = 0; i < nmat; ++i)
     {
-        std::string m(tbl.get_F(mat.at(i)));
-        std::string fname(dirpath + m + "/" + m + allparam);
-        std::ifstream infile(fname.c_str());
-        if (!infile.is_open())
+        double z = zbar_row(mid[i], ite, itr)[ine];
+        if (std::isnan(z))
         {
-            std::cerr << "Error: file " << fname << " is not open in "
-                      << "Database::load_zbars" << std::endl;
+            std::cerr << "Error: zbar of " << utils::fname_root(
+                         material_name(mid[i]),
+                         get_te_str_at(ite), get_tr_str_at(itr),
+                         get_ne_str_at(ine)) << " is not in Database "
+                      << path << " in Database::load_zbars" << std::endl;
             exit(EXIT_FAILURE);
         }
-        utils::find_word(infile, "zbar");
-        double zbar;
-        infile >> zbar;
-        zb.emplace_back(std::move(zbar));
-        infile.close();
-        infile.clear();
+        zb.emplace_back(std::move(z));
     }
 }
 
@@ -381,15 +1534,29 @@ NeData Database::find_ne(const Table &tbl, const double te_in, size_t &ite,
                          size_t &ine) const
 {
     NeData rv;
-    rv.second = "_te" + nearest_te_str(te_in, ite) + "ev_tr"
-              + nearest_tr_str(tr_in, itr) + "ev_ne";
-    rv.first = nearest_ne(rv.second, tbl, np, nmat, mat, fp, ine);
-    rv.second += get_ne_str_at(ine) + "pcc_";
+    rv.first = find_ne(te_in, ite, tr_in, itr, np, nmat,
+                       material_index(tbl, nmat, mat), fp, ine);
+    rv.second = "_te" + get_te_str_at(ite) + "ev_tr" + get_tr_str_at(itr)
+              + "ev_ne" + get_ne_str_at(ine) + "pcc_";
     return rv;
 }
 
 //-----------------------------------------------------------------------------
 
+double Database::find_ne(const double te_in, size_t &ite,
+                         const double tr_in, size_t &itr,
+                         const double np, const unsigned short int nmat,
+                         const std::vector<size_t> &mid,
+                         const std::vector<double> &fp,
+                         size_t &ine) const
+{
+    ite = utils::nearest(te_in, te, nte, ite);
+    itr = utils::nearest(tr_in, tr, ntr, itr);
+    return nearest_ne(ite, itr, np, nmat, mid, fp, ine);
+}
+
+//-----------------------------------------------------------------------------
+
 std::ostream & operator << (std::ostream &ost, const Database &o)
 {
     ost << o.to_string();
@@ -398,23 +1565,46 @@ std::ostream & operator << (std::ostream &ost, const Database &o)
 
 //-----------------------------------------------------------------------------
 
-StoichZbar::StoichZbar(const Database * const dp_in, const Table &tbl_in,
-                       const std::string &frt_in,
+StoichZbar::StoichZbar(const Database * const dp_in,
+                       const size_t ite_in, const size_t itr_in,
                        const double nps_in,
                        const unsigned short int nms_in,
-                       const std::vector<std::string> &mts_in,
+                       const std::vector<size_t> &mid_in,
                        const std::vector<double> &fps_in): dp(dp_in),
-    tbl(tbl_in), frt(frt_in), nps(nps_in), nms(nms_in), mts(mts_in),
-    fps(fps_in) {}
+    ite(ite_in), itr(itr_in), nps(nps_in),
+    nms(nms_in), mid(mid_in), fps(fps_in), zbr(), mono(true)
+{
+    zbr.reserve(nms);
+    for (unsigned short int i = 0; i < nms; ++i)
+    {
+        zbr.push_back(dp->zbar_row(mid[i], ite, itr));
+        mono = mono  &&  dp->zbar_row_monotone(mid[i], ite, itr);
+    }
+}
 
 //-----------------------------------------------------------------------------
 
 double StoichZbar::operator[](const size_t ine) const
 {
-    std::vector<double> zbars;
-    zbars.reserve(nms);
-    dp->load_zbars(frt, tbl, nms, mts, ine, zbars);
-    return dp->get_ne_at(ine) - utils::ne_charge_neut(nps, nms, fps, zbars);
+    double s(0.0); // same summation as utils::ne_charge_neut
+    for (unsigned short int i = 0; i < nms; ++i)
+    {
+        double z = zbr[i][ine];
+        if (std::isnan(z))
+        {   // report the missing entry the same way as Database::load_zbars
+            std::vector<double> zbars;
+            dp->load_zbars(ite, itr, nms, mid, ine, zbars);
+        }
+        s += fps[i] * z;
+    }
+    return dp->get_ne_at(ine) - s * nps;
+}
+
+//-----------------------------------------------------------------------------
+
+bool StoichZbar::is_monotone() const
+{
+    return mono;
 }
 
 //-----------------------------------------------------------------------------
@@ -7,21 +7,35 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 31 December 2014\n
- * Last modified on 8 March 2022
+ * Last modified on 17 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
  * See top-level license.txt file for full license text.
  */
 
+#include <ArrDbl.h>
+#include <DbPack.h>
 #include <Table.h>
 #include <utils.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 #include <utility>
 
+#ifndef WIN
+#include <pthread.h>
+#endif
+
 //-----------------------------------------------------------------------------
 
 /** @brief Return value from the charge-neutrality constraint;\n
@@ -32,6 +46,356 @@ typedef std::pair<double, std::string> NeData;
 
 //-----------------------------------------------------------------------------
 
+/** @brief Floating-point type of cached and mixed spectra; float with
+ * -DSINGLE (makefile: single = yes), which halves the memory held by the
+ * Database caches; storage only: Ray spectra and intensities, and Detector
+ * integrals, stay double
+ */
+#ifdef SINGLE
+typedef float SpecReal;
+#else
+typedef double SpecReal;
+#endif
+
+//-----------------------------------------------------------------------------
+
+/** @brief Reader/writer lock of the Database caches: cache hits share it,
+ * insertions and evictions own it (POSIX rwlock; a plain mutex on Windows)
+ */
+class CacheLock
+{
+public:
+
+    /// Default constructor
+    CacheLock();
+
+    /**
+     * @brief Copy constructor
+     * @param[in] o CacheLock object to be copied (deleted)
+     */
+    CacheLock(const CacheLock &o) = delete;
+
+    /**
+     * @brief Overloaded assignment operator
+     * @param[in] o CacheLock object to be copied (deleted)
+     * @return Reference to copied object
+     */
+    CacheLock &operator=(const CacheLock &o) = delete;
+
+    /// Destructor
+    ~CacheLock();
+
+    /// Exclusive (writer) ownership, as for std::lock_guard
+    void lock();
+
+    /// Releases exclusive ownership
+    void unlock();
+
+    /// Shared (reader) ownership, as for SharedGuard
+    void lock_shared();
+
+    /// Releases shared ownership
+    void unlock_shared();
+
+
+private:
+
+#ifdef WIN
+    /// Mutual exclusion for readers and writers alike
+    std::mutex mtx;
+#else
+    /// POSIX reader/writer lock
+    pthread_rwlock_t rw;
+#endif
+};
+
+//-----------------------------------------------------------------------------
+
+/// Scoped shared (reader) ownership of a CacheLock
+class SharedGuard
+{
+public:
+
+    /**
+     * @brief Parametrized constructor: takes shared ownership of l
+     * @param[in,out] l Lock to be held until destruction
+     */
+    explicit SharedGuard(CacheLock &l): lk(l) {lk.lock_shared();}
+
+    /**
+     * @brief Copy constructor
+     * @param[in] o SharedGuard object to be copied (deleted)
+     */
+    SharedGuard(const SharedGuard &o) = delete;
+
+    /**
+     * @brief Overloaded assignment operator
+     * @param[in] o SharedGuard object to be copied (deleted)
+     * @return Reference to copied object
+     */
+    SharedGuard &operator=(const SharedGuard &o) = delete;
+
+    /// Destructor: releases the shared ownership
+    ~SharedGuard() {lk.unlock_shared();}
+
+
+private:
+
+    /// Lock held by *this
+    CacheLock &lk;
+};
+
+//-----------------------------------------------------------------------------
+
+/// Integer key of spectral data for one material at one Database grid point
+struct SpecKey
+{
+    /// Material index (see Database::material_index)
+    size_t mat;
+
+    /// Electron temperature Database index
+    size_t ite;
+
+    /// Radiation temperature Database index
+    size_t itr;
+
+    /// Electron number density Database index
+    size_t ine;
+
+    /**
+     * @brief Parametrized constructor
+     * @param[in] mat_in Initializes SpecKey::mat
+     * @param[in] ite_in Initializes SpecKey::ite
+     * @param[in] itr_in Initializes SpecKey::itr
+     * @param[in] ine_in Initializes SpecKey::ine
+     */
+    SpecKey(const size_t mat_in, const size_t ite_in,
+            const size_t itr_in, const size_t ine_in):
+        mat(mat_in), ite(ite_in), itr(itr_in), ine(ine_in) {}
+
+    /// Lexicographic ordering, so that SpecKey can be used as a std::map key
+    bool operator < (const SpecKey &o) const
+    {
+        if (mat != o.mat) return mat < o.mat;
+        if (ite != o.ite) return ite < o.ite;
+        if (itr != o.itr) return itr < o.itr;
+        return ine < o.ine;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+/// Spectral data of one SpecKey, held within the range [jmin, jmax] of hv
+struct SpecData
+{
+    /// Lower limit of the stored hv-grid range
+    size_t jmin;
+
+    /// Upper limit of the stored hv-grid range
+    size_t jmax;
+
+    /// Monochromatic emissivity per particle
+    std::vector<SpecReal> em;
+
+    /// Monochromatic absorption coefficient per particle
+    std::vector<SpecReal> ab;
+
+    /// Monochromatic scattering coefficient per particle
+    std::vector<SpecReal> sc;
+
+    /// Last use (Database::cache_clock); stamped by readers that share
+    /// Database::cache_lock, hence atomic
+    mutable std::atomic<size_t> used;
+
+    /// Default constructor
+    SpecData(): jmin(0), jmax(0), em(), ab(), sc(), used(0) {}
+
+    /**
+     * @brief Move constructor (for insertion into Database::spec_cache)
+     * @param[in] o SpecData object to be moved
+     */
+    SpecData(SpecData &&o): jmin(o.jmin), jmax(o.jmax), em(std::move(o.em)),
+        ab(std::move(o.ab)), sc(std::move(o.sc)), used(o.used.load()) {}
+
+    /**
+     * @brief Memory held by the spectral arrays
+     * @return Size of em, ab, sc in bytes
+     */
+    size_t bytes() const {return 3 * (jmax - jmin + 1) * sizeof(SpecReal);}
+};
+
+//-----------------------------------------------------------------------------
+
+/** @brief Key of mixed spectra of one Zone material state: Database
+ * material indices and snapped grid indices, with the exact fractions and
+ * particle density (see Database::get_mixture)
+ */
+struct MixKey
+{
+    /// Material indices (see Database::material_index)
+    std::vector<size_t> mid;
+
+    /// Fractional populations of materials
+    std::vector<double> fp;
+
+    /// Total particle number density (particles/cm3)
+    double np;
+
+    /// Electron temperature Database index
+    size_t ite;
+
+    /// Radiation temperature Database index
+    size_t itr;
+
+    /// Electron number density Database index
+    size_t ine;
+
+    /// Lower index of the photon energy grid
+    size_t jmin;
+
+    /// Upper index of the photon energy grid
+    size_t jmax;
+
+    /// Lexicographic ordering, so that MixKey can be used as a std::map key
+    bool operator < (const MixKey &o) const
+    {
+        return std::tie(ite, itr, ine, jmin, jmax, np, mid, fp) <
+               std::tie(o.ite, o.itr, o.ine, o.jmin, o.jmax, o.np, o.mid, o.fp);
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+/// Mixed spectra of one MixKey, multiplied by the particle density
+struct MixData
+{
+    /// Mixed monochromatic emissivity ( W / cm3 / sr / eV )
+    std::vector<SpecReal> em;
+
+    /// Mixed monochromatic absorption ( 1 / cm )
+    std::vector<SpecReal> ab;
+
+    /// Mixed monochromatic scattering ( 1 / cm )
+    std::vector<SpecReal> sc;
+
+    /// Last use (Database::cache_clock), as in SpecData::used
+    mutable std::atomic<size_t> used;
+
+    /// Default constructor
+    MixData(): em(), ab(), sc(), used(0) {}
+
+    /**
+     * @brief Move constructor (for insertion into Database::mix_cache)
+     * @param[in] o MixData object to be moved
+     */
+    MixData(MixData &&o): em(std::move(o.em)), ab(std::move(o.ab)),
+        sc(std::move(o.sc)), used(o.used.load()) {}
+
+    /**
+     * @brief Memory held by the spectral arrays
+     * @return Size of em, ab, sc in bytes
+     */
+    size_t bytes() const
+    {
+        return (em.size() + ab.size() + sc.size()) * sizeof(SpecReal);
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+/** @brief Photon energy bands of a Detector in band-averaged (multigroup)
+ * mode: each band is an index range of the Database hv grid, over which
+ * the Database averages spectra once per grid point (see Database::get_bands)
+ */
+struct BandSet
+{
+    /// Lower hv-grid index of each band
+    std::vector<size_t> jlo;
+
+    /// Upper hv-grid index of each band
+    std::vector<size_t> jhi;
+
+    /// Weight of the opacity means: "planck" or "rosseland"
+    std::string weight;
+
+    /**
+     * @brief Number of bands
+     * @return Size of jlo and jhi
+     */
+    size_t size() const {return jlo.size();}
+
+    /// Lexicographic ordering, so that equal BandSets are registered once
+    bool operator < (const BandSet &o) const
+    {
+        return std::tie(weight, jlo, jhi) < std::tie(o.weight, o.jlo, o.jhi);
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+/// Materials and Database index ranges needed by one run
+struct DbSubset
+{
+    /// Material file handles (from Table::get_F)
+    std::vector<std::string> mat;
+
+    /// Lower limit of the electron temperature index range
+    size_t ite0;
+
+    /// Upper limit of the electron temperature index range
+    size_t ite1;
+
+    /// Lower limit of the radiation temperature index range
+    size_t itr0;
+
+    /// Upper limit of the radiation temperature index range
+    size_t itr1;
+
+    /// Lower limit of the electron number density index range
+    size_t ine0;
+
+    /// Upper limit of the electron number density index range
+    size_t ine1;
+
+    /// Lower limit of the hv-grid range
+    size_t jmin;
+
+    /// Upper limit of the hv-grid range
+    size_t jmax;
+
+    /// Default constructor: empty ranges (lower limit above upper limit)
+    DbSubset(): mat(), ite0(SIZE_MAX), ite1(0), itr0(SIZE_MAX), itr1(0),
+        ine0(SIZE_MAX), ine1(0), jmin(SIZE_MAX), jmax(0) {}
+
+    /**
+     * @brief Widens the ranges to include one Database grid point
+     * @param[in] m Material file handle (from Table::get_F)
+     * @param[in] ite Electron temperature Database index
+     * @param[in] itr Radiation temperature Database index
+     * @param[in] ine Electron number density Database index
+     */
+    void add(const std::string &m, const size_t ite,
+             const size_t itr, const size_t ine)
+    {
+        if (std::find(mat.begin(), mat.end(), m) == mat.end())
+            mat.push_back(m);
+        ite0 = std::min(ite0, ite);
+        ite1 = std::max(ite1, ite);
+        itr0 = std::min(itr0, itr);
+        itr1 = std::max(itr1, itr);
+        ine0 = std::min(ine0, ine);
+        ine1 = std::max(ine1, ine);
+    }
+
+    /**
+     * @brief Flags a subset without any Database grid point
+     * @return true, if add() has not been called
+     */
+    bool empty() const {return mat.empty();}
+};
+
+//-----------------------------------------------------------------------------
+
 /// Equation-of-State (EOS) and spectral grids, and access
 class Database
 {
@@ -50,6 +414,19 @@ public:
     Database(const std::string &t, const std::string &p,
              const bool td);
 
+    /**
+     * @brief Parametrized constructor:
+     *        loads temperature, density, spectral grids, and selects the
+     *        packed binary backend for EOS and spectral data
+     * @param[in] t Path to TOPS executable (can be "none")
+     * @param[in] p Path to grid data files (used if t == "none")
+     * @param[in] td Flags whether p is "tops_default/" or not
+     * @param[in] pk Name of the packed Database file (see DbPack);
+     *            if empty, the text layout under p is used
+     */
+    Database(const std::string &t, const std::string &p,
+             const bool td, const std::string &pk);
+
     /**
      * @brief Getter for TOPS path (Database::tops_cmnd)
      * @return Path to TOPS executable
@@ -67,6 +444,77 @@ public:
      * @return tops_default/ path flag
      */
     bool get_tops_default() const;
+
+    /**
+     * @brief Flags whether EOS and spectral data come from a packed file
+     * @return true, if *this uses the DbPack backend
+     */
+    bool is_packed() const;
+
+    /**
+     * @brief Writes the EOS and spectral data of the text layout under
+     *        Database::path into one packed file (see DbPack)
+     * @param[in] fname Name of the packed file to be written
+     * @return Number of (material, te, tr, ne) records written
+     */
+    size_t write_pack(const std::string &fname) const;
+
+    /**
+     * @brief Writes the part of the text layout under Database::path that
+     *        is needed by one run into a new text Database: te, tr grids
+     *        and EOS data are restricted to the index ranges of s (EOS data
+     *        keep the full ne grid for the charge-neutrality search),
+     *        spectra are restricted to the ne and hv ranges of s
+     * @param[in] dest Path of the new Database (including the trailing "/")
+     * @param[in] s Materials and index ranges to be kept
+     * @return Number of EOS and spectral files written
+     */
+    size_t write_subset(const std::string &dest, const DbSubset &s) const;
+
+    /**
+     * @brief Rebuilds the zbar table and the spectral catalog from the
+     *        Database files, ignoring any catalog index
+     */
+    void scan();
+
+    /**
+     * @brief Writes the catalog index: zbar values and the availability of
+     *        spectra at all (material, te, tr, ne) points, read at later
+     *        constructions instead of scanning the Database directories;
+     *        it is ignored once files are added to or removed from eos/ or
+     *        spectra/ (see catalog_stamp), until it is written again
+     * @param[in] fname Name of the index file (cnststr::CATALOG_FNAME in
+     *            the Database directory)
+     * @return Number of (material, te, tr, ne) records written
+     */
+    size_t write_catalog(const std::string &fname) const;
+
+    /**
+     * @brief Flags whether the zbar table and the spectral catalog were read
+     *        from a catalog index
+     * @return true, if cnststr::CATALOG_FNAME was used at construction
+     */
+    bool is_cataloged() const;
+
+    /**
+     * @brief Flags whether spectra exist at one Database grid point
+     * @param[in] imat Material index (see material_index)
+     * @param[in] ite Electron temperature Database index
+     * @param[in] itr Radiation temperature Database index
+     * @param[in] ine Electron number density Database index
+     * @return true, if em, ab, sc are in the Database
+     */
+    bool has_spectra(const size_t imat, const size_t ite,
+                     const size_t itr, const size_t ine) const;
+
+    /**
+     * @brief Verifies that the EOS and spectral data of all lookups of a
+     *        run exist, before the run starts
+     * @param[in] keys Lookups (see Diagnostics::lookups)
+     * @param[in,out] ost Output stream listing the missing data
+     * @return Number of keys with missing data
+     */
+    size_t check(const std::set<SpecKey> &keys, std::ostream &ost) const;
     
     /**
      * @brief Getter for number of bits in electron temperature grid
@@ -255,9 +703,264 @@ public:
      */
     std::string to_string() const;
 
+    /**
+     * @brief Integer label of a material file handle, assigned on first use;
+     *        materials with EOS data are labeled by their Database::zbar
+     *        rows (by their positions in the packed file, if is_packed())
+     * @param[in] m Material file handle (from Table::get_F)
+     * @return Material index used in SpecKey::mat and the integer lookups
+     */
+    size_t material_index(const std::string &m) const;
+
+    /**
+     * @brief Integer labels of the materials in a Zone (see material_index)
+     * @param[in] tbl Table of materials
+     * @param[in] nmat Number of materials in the Zone
+     * @param[in] mat List of materials in the Zone
+     * @return Material indices, in the order of mat
+     */
+    std::vector<size_t> material_index(const Table &tbl,
+                                       const unsigned short int nmat,
+                                       const std::vector<std::string> &mat)
+                                       const;
+
+    /**
+     * @brief Retrieves spectra of one material at one Database grid point,
+     *        reading them from files only if they are not already cached
+     *        (copied straight from the memory map, if is_packed())
+     * @param[in] m Material file handle (from Table::get_F)
+     * @param[in] ite Electron temperature Database index
+     * @param[in] itr Radiation temperature Database index
+     * @param[in] ine Electron number density Database index
+     * @param[in] jmin Lower limit of the requested hv-grid range
+     * @param[in] jmax Upper limit of the requested hv-grid range
+     * @param[out] em Emissivity within [jmin, jmax]
+     * @param[out] ab Absorption coefficient within [jmin, jmax]
+     * @param[out] sc Scattering coefficient within [jmin, jmax]
+     */
+    void get_spectra(const std::string &m, const size_t ite,
+                     const size_t itr, const size_t ine,
+                     const size_t jmin, const size_t jmax,
+                     ArrDbl &em, ArrDbl &ab, ArrDbl &sc) const;
+
+    /**
+     * @brief Retrieves spectra of one material at one Database grid point;
+     *        same as above, without any string work on a cache hit
+     * @param[in] imat Material index (see material_index)
+     * @param[in] ite Electron temperature Database index
+     * @param[in] itr Radiation temperature Database index
+     * @param[in] ine Electron number density Database index
+     * @param[in] jmin Lower limit of the requested hv-grid range
+     * @param[in] jmax Upper limit of the requested hv-grid range
+     * @param[out] em Emissivity within [jmin, jmax]
+     * @param[out] ab Absorption coefficient within [jmin, jmax]
+     * @param[out] sc Scattering coefficient within [jmin, jmax]
+     */
+    void get_spectra(const size_t imat, const size_t ite,
+                     const size_t itr, const size_t ine,
+                     const size_t jmin, const size_t jmax,
+                     ArrDbl &em, ArrDbl &ab, ArrDbl &sc) const;
+
+    /**
+     * @brief Getter for the number of spectral cache hits
+     * @return Number of get_spectra calls served from memory
+     */
+    size_t get_cache_hits() const;
+
+    /**
+     * @brief Getter for the number of spectral cache misses
+     * @return Number of get_spectra calls that read Database files
+     */
+    size_t get_cache_misses() const;
+
+    /**
+     * @brief Getter for the number of spectral cache entries
+     * @return Number of SpecKey entries held in memory
+     */
+    size_t get_cache_size() const;
+
+    /**
+     * @brief Getter for the number of cache evictions
+     * @return Number of spectral, mixture and band cache entries dropped to
+     *         stay within the byte budget
+     */
+    size_t get_cache_evictions() const;
+
+    /**
+     * @brief Getter for the memory held by the spectral cache
+     * @return Bytes of spectral and band-averaged data currently held in
+     *         memory
+     */
+    size_t get_cache_bytes() const;
+
+    /**
+     * @brief Setter for the byte budget shared by the spectral and mixture
+     *        caches; least recently used entries of either are evicted to
+     *        stay within it
+     * @param[in] b Byte budget (0 means unbounded)
+     */
+    void set_cache_budget(const size_t b);
+
+    /**
+     * @brief Getter for the byte budget of the spectral and mixture caches
+     * @return Byte budget (0 means unbounded)
+     */
+    size_t get_cache_budget() const;
+
+    /**
+     * @brief String summary of the spectral cache usage
+     * @return Entries, hits, misses, evictions, and resident bytes of the
+     *         spectral cache
+     *         (name of the packed file, if is_packed())
+     */
+    std::string cache_to_string() const;
+
+    /**
+     * @brief Retrieves mixed spectra of one Zone material state, if they
+     *        were stored by put_mixture() (at this or an earlier time step)
+     * @param[in] key Material state
+     * @param[out] em Mixed monochromatic emissivity ( W / cm3 / sr / eV )
+     * @param[out] ab Mixed monochromatic absorption ( 1 / cm )
+     * @param[out] sc Mixed monochromatic scattering ( 1 / cm )
+     * @return true, if found (em, ab, sc are untouched otherwise)
+     */
+    bool get_mixture(const MixKey &key,
+                     ArrDbl &em, ArrDbl &ab, ArrDbl &sc) const;
+
+    /**
+     * @brief Stores mixed spectra of one Zone material state; least
+     *        recently used entries of the spectral and mixture caches are
+     *        evicted, if both together exceed the cache byte budget
+     * @param[in] key Material state
+     * @param[in] em Mixed monochromatic emissivity ( W / cm3 / sr / eV )
+     * @param[in] ab Mixed monochromatic absorption ( 1 / cm )
+     * @param[in] sc Mixed monochromatic scattering ( 1 / cm )
+     */
+    void put_mixture(const MixKey &key, const ArrDbl &em,
+                     const ArrDbl &ab, const ArrDbl &sc) const;
+
+    /**
+     * @brief Getter for the number of mixture cache entries
+     * @return Number of distinct mixed material states held in memory
+     */
+    size_t get_mix_size() const;
+
+    /**
+     * @brief Getter for the number of mixture cache hits
+     * @return Number of get_mixture calls that found their MixKey
+     */
+    size_t get_mix_hits() const;
+
+    /**
+     * @brief Dedup ratio of the mixture cache
+     * @return Mixtures requested per mixture computed (1 if none)
+     */
+    double get_mix_dedup() const;
+
+    /**
+     * @brief Registers a BandSet for get_bands(); equal BandSets share
+     *        their index, and hence their band-averaged data
+     * @param[in] b Bands within the Database hv grid
+     * @return Index of b, to be passed to get_bands()
+     */
+    size_t band_index(const BandSet &b) const;
+
+    /**
+     * @brief Band-averaged optical data per particle of one Database grid
+     *        point, computed from get_spectra() on first use and kept:\n
+     *        em is the hv-average over each band (exact for band-integrated
+     *        emission in the optically thin limit);\n
+     *        ab and sc are Planck means (weight B(hv, te)), or their sum is
+     *        a Rosseland mean (weight dB/dte, harmonic) split in the ratio
+     *        of the Planck means, as selected by BandSet::weight;
+     *        te is the grid value at ite (hv-average if te is 0)
+     * @param[in] imat Material index (see material_index)
+     * @param[in] ite Electron temperature index
+     * @param[in] itr Radiation temperature index
+     * @param[in] ine Electron density index
+     * @param[in] ib BandSet index (see band_index)
+     * @param[out] em Band-averaged emissivity per particle
+     * @param[out] ab Band-averaged absorption coefficient per particle
+     * @param[out] sc Band-averaged scattering coefficient per particle
+     */
+    void get_bands(const size_t imat, const size_t ite, const size_t itr,
+                   const size_t ine, const size_t ib,
+                   ArrDbl &em, ArrDbl &ab, ArrDbl &sc) const;
+
+    /**
+     * @brief Getter for the number of band-averaged cache entries
+     * @return Number of (grid point, BandSet) pairs held in memory
+     */
+    size_t get_band_size() const;
+
+    /**
+     * @brief Trapezoidal quadrature weights over one band of a grid
+     * @param[in] x Grid (e.g., photon energies in eV)
+     * @param[in] klo Lower index of the band within x
+     * @param[in] khi Upper index of the band within x
+     * @return Weights of x[klo..khi] (all 1, if klo == khi)
+     */
+    static std::vector<double> band_weights(const std::vector<double> &x,
+                                            const size_t klo,
+                                            const size_t khi);
+
+    /**
+     * @brief Getter for number of materials in the preloaded zbar table
+     * @return Number of materials with EOS data
+     */
+    size_t get_nzbar_mat() const;
+
+    /**
+     * @brief Average ionizations of one material along the ne grid,
+     *        from the table preloaded at construction
+     * @param[in] m Material file handle (from Table::get_F)
+     * @param[in] ite Electron temperature Database index
+     * @param[in] itr Radiation temperature Database index
+     * @return Pointer to nne zbar values, indexed by ine;
+     *         NaN marks values absent from the Database
+     */
+    const double * zbar_row(const std::string &m,
+                            const size_t ite, const size_t itr) const;
+
+    /**
+     * @brief Average ionizations of one material along the ne grid
+     * @param[in] imat Material index (see material_index)
+     * @param[in] ite Electron temperature Database index
+     * @param[in] itr Radiation temperature Database index
+     * @return Pointer to nne zbar values, indexed by ine;
+     *         NaN marks values absent from the Database
+     */
+    const double * zbar_row(const size_t imat,
+                            const size_t ite, const size_t itr) const;
+
+    /**
+     * @brief Flags a zbar row (see zbar_row) that is complete and
+     *        non-increasing along the ne grid
+     * @param[in] m Material file handle (from Table::get_F)
+     * @param[in] ite Electron temperature Database index
+     * @param[in] itr Radiation temperature Database index
+     * @return true, if the charge-neutrality residual of any mixture made of
+     *         such rows increases monotonically with ne
+     */
+    bool zbar_row_monotone(const std::string &m,
+                           const size_t ite, const size_t itr) const;
+
+    /**
+     * @brief Flags a zbar row (see zbar_row) that is complete and
+     *        non-increasing along the ne grid
+     * @param[in] imat Material index (see material_index)
+     * @param[in] ite Electron temperature Database index
+     * @param[in] itr Radiation temperature Database index
+     * @return true, if the charge-neutrality residual of any mixture made of
+     *         such rows increases monotonically with ne
+     */
+    bool zbar_row_monotone(const size_t imat,
+                           const size_t ite, const size_t itr) const;
+
     /**
      * @brief Retrieves average ionization for all materials
-     * @param[in] froot File-name root based on te, tr
+     * @param[in] ite Electron temperature Database index
+     * @param[in] itr Radiation temperature Database index
      * @param[in] tbl Table of materials
      * @param[in] nmat Number of materials in the Zone
      * @param[in] mat List of materials in the Zone
@@ -265,11 +968,26 @@ public:
      * @param[out] zb Material average ionizations from Database at index ine
      *             (zb is assumed to be empty on entry)
      */
-    void load_zbars(const std::string &froot, const Table &tbl,
+    void load_zbars(const size_t ite, const size_t itr, const Table &tbl,
                     const unsigned short int nmat,
                     const std::vector<std::string> &mat,
                     const size_t ine, std::vector<double> &zb) const;
 
+    /**
+     * @brief Retrieves average ionization for all materials
+     * @param[in] ite Electron temperature Database index
+     * @param[in] itr Radiation temperature Database index
+     * @param[in] nmat Number of materials in the Zone
+     * @param[in] mid Material indices in the Zone (see material_index)
+     * @param[in] ine Electron number density Database index
+     * @param[out] zb Material average ionizations from Database at index ine
+     *             (zb is assumed to be empty on entry)
+     */
+    void load_zbars(const size_t ite, const size_t itr,
+                    const unsigned short int nmat,
+                    const std::vector<size_t> &mid,
+                    const size_t ine, std::vector<double> &zb) const;
+
     /**
      * @brief Finds common electron number density that is consistent with
      *        the charge-neutrality constraint for given temperature and
@@ -295,6 +1013,28 @@ public:
                    const std::vector<double> &fp,
                    size_t &ine) const;
 
+    /**
+     * @brief Finds common electron number density that is consistent with
+     *        the charge-neutrality constraint; same as above, without any
+     *        string work (for the per-Zone-crossing path)
+     * @param[in] te_in Electron temperature in the Zone
+     * @param[in,out] ite Electron temperature Database index
+     * @param[in] tr_in Radiation temperature in the Zone
+     * @param[in,out] itr Radiation temperature Database index
+     * @param[in] np Total particle number density (particles/cm3)
+     * @param[in] nmat Number of materials in the Zone
+     * @param[in] mid Material indices in the Zone (see material_index)
+     * @param[in] fp Fractional populations of materials
+     * @param[in,out] ine Electron number density Database index
+     * @return Actual (not Table) electron number density in electrons/cm3
+     */
+    double find_ne(const double te_in, size_t &ite,
+                   const double tr_in, size_t &itr,
+                   const double np, const unsigned short int nmat,
+                   const std::vector<size_t> &mid,
+                   const std::vector<double> &fp,
+                   size_t &ine) const;
+
 
 private:
 
@@ -373,6 +1113,111 @@ private:
     /// Photon energy grid (eV)
     std::vector<double> hv;
 
+    /// Material file handles mapped to their SpecKey::mat labels
+    mutable std::map<std::string, size_t> mat_index;
+
+    /// Material file handles, indexed by their SpecKey::mat labels
+    mutable std::vector<std::string> mat_name;
+
+    /// Spectral data already read from files (process-wide)
+    mutable std::map<SpecKey, SpecData> spec_cache;
+
+    /// Number of get_spectra calls served from Database::spec_cache
+    mutable std::atomic<size_t> cache_hits;
+
+    /// Number of get_spectra calls that had to read files
+    mutable std::atomic<size_t> cache_misses;
+
+    /// Use counter of Database::spec_cache, Database::mix_cache and
+    /// Database::band_cache (see SpecData::used, MixData::used); the least
+    /// recently used entries are evicted first
+    mutable std::atomic<size_t> cache_clock;
+
+    /// Bytes held in Database::spec_cache and Database::band_cache (see
+    /// SpecData::bytes, MixData::bytes)
+    mutable size_t cache_bytes;
+
+    /// Number of entries evicted from Database::spec_cache,
+    /// Database::mix_cache and Database::band_cache
+    mutable size_t cache_evictions;
+
+    /// Byte budget of Database::spec_cache, Database::mix_cache and
+    /// Database::band_cache together (0 means unbounded)
+    size_t cache_budget;
+
+    /// Mixed spectra of Zone material states, kept across time steps
+    mutable std::map<MixKey, MixData> mix_cache;
+
+    /// Bytes held in Database::mix_cache (see MixData::bytes)
+    mutable size_t mix_bytes;
+
+    /// Number of get_mixture calls served from Database::mix_cache
+    mutable std::atomic<size_t> mix_hits;
+
+    /// Number of put_mixture calls (mixtures computed)
+    mutable size_t mix_puts;
+
+    /// BandSets registered by band_index()
+    mutable std::vector<BandSet> band_sets;
+
+    /// Band-averaged data per (BandSet index, grid point), per particle
+    mutable std::map<std::pair<size_t, SpecKey>, MixData> band_cache;
+
+    /// Guards Database::mat_index, Database::mat_name, Database::spec_cache,
+    /// Database::mix_cache, the band data, and the counters; spectral,
+    /// mixture and band cache hits hold it shared, so that threads read the
+    /// caches concurrently
+    mutable CacheLock cache_lock;
+
+    /// Packed EOS and spectral data; nullptr, if the text layout is used
+    std::shared_ptr<const DbPack> pack;
+
+    /// Material file handles mapped to their rows in Database::zbar
+    std::map<std::string, size_t> zbar_mat;
+
+    /// Average ionizations, [material][te][tr][ne] with ne running fastest
+    std::vector<double> zbar;
+
+    /// Monotonicity flags of Database::zbar rows, [material][te][tr]
+    std::vector<bool> zbar_mono;
+
+    /// Availability of spectra, indexed as Database::zbar
+    std::vector<bool> spec_avail;
+
+    /// Flags whether the catalog index was read at construction
+    bool cataloged;
+
+    /**
+     * @brief Fills Database::zbar_mat, Database::zbar, Database::zbar_mono,
+     *        and Database::spec_avail from the EOS and spectral data
+     * @param[in] use_index Read the catalog index instead of scanning the
+     *            Database directories, if the index exists
+     */
+    void load_zbar_table(const bool use_index);
+
+    /**
+     * @brief Fills Database::zbar_mat, Database::zbar, Database::spec_avail
+     *        from a catalog index (see write_catalog)
+     * @param[in] fname Name of the index file
+     * @return false, if the file is absent, or does not match the grids
+     *         or the current catalog_stamp()
+     */
+    bool read_catalog(const std::string &fname);
+
+    /**
+     * @brief Validity stamp of a catalog index: the number of files in each
+     *        material directory of eos/ and spectra/
+     * @return One "<dir>/<material> <nfiles>" line per directory
+     */
+    std::string catalog_stamp() const;
+
+    /**
+     * @brief Material file handle of an integer label
+     * @param[in] imat Material index (see material_index)
+     * @return Material file handle
+     */
+    std::string material_name(const size_t imat) const;
+
     /**
      * @brief Read a file with grid information
      * @param[in] fname Name of input file with grid information
@@ -388,25 +1233,46 @@ private:
                         std::vector<double> &v,
                         std::vector<std::string> &v_str);
 
+    /**
+     * @brief Copies the points [i0, i1] of a grid file into a new grid file
+     * @param[in] src Name of the existing grid file
+     * @param[in] dst Name of the grid file to be written
+     * @param[in] i0 First grid point to be kept
+     * @param[in] i1 Last grid point to be kept
+     */
+    static void write_grid_slice(const std::string &src,
+                                 const std::string &dst,
+                                 const size_t i0, const size_t i1);
+
     /**
      * @brief Search EOS database for the common electron number density
      *        shared by all materials in the Zone and consistent with the
      *        charge-neutrality constraint
-     * @param[in] froot File-name root based on te, tr
-     * @param[in] tbl Table of materials
+     * @param[in] ite Electron temperature Database index
+     * @param[in] itr Radiation temperature Database index
      * @param[in] np Total atom number density (ions/cm3)
      * @param[in] nmat Number of materials in the Zone
-     * @param[in] mat List of materials in the Zone
+     * @param[in] mid Material indices in the Zone (see material_index)
      * @param[in] fp Fractional populations of materials in the Zone
      * @param[in,out] ine Electron number density Database index
      * @return Mixed electron number density closest to a Database point
-     * @todo Consider replacing the exhaustive search with a (faster) binary
-     *       search seeded by the previously obtained value of ine
+     *
+     * The search is a bracketed bisection seeded by the incoming ine when
+     * the residual is known to be monotone (StoichZbar::is_monotone),
+     * and an exhaustive scan of the ne grid otherwise
      */
-    double nearest_ne(const std::string &froot, const Table &tbl,
+    double nearest_ne(const size_t ite, const size_t itr,
                       const double np, const unsigned short int nmat,
-                      const std::vector<std::string> &mat,
+                      const std::vector<size_t> &mid,
                       const std::vector<double> &fp, size_t &ine) const;
+
+    /**
+     * @brief Evicts least recently used entries of Database::spec_cache,
+     *        Database::mix_cache and Database::band_cache until they fit in
+     *        Database::cache_budget; called with Database::cache_lock owned
+     * @param[in] keep Use stamp of the newest entry, which is never evicted
+     */
+    void evict(const size_t keep) const;
 };
 
 //-----------------------------------------------------------------------------
@@ -433,18 +1299,18 @@ public:
     /**
      * @brief Parametrized constructor
      * @param[in] dp_in Pointer to parent Database object
-     * @param[in] tbl_in Reference to Table object
-     * @param[in] frt_in File-name root based on te, tr
+     * @param[in] ite_in Electron temperature Database index
+     * @param[in] itr_in Radiation temperature Database index
      * @param[in] nps_in Total particle number density (particles/cm3)
      * @param[in] nms_in Number of materials
-     * @param[in] mts_in Material IDs
+     * @param[in] mid_in Material indices (see Database::material_index)
      * @param[in] fps_in Fractional populations of materials
      */
-    StoichZbar(const Database * const dp_in, const Table &tbl_in,
-               const std::string &frt_in,
+    StoichZbar(const Database * const dp_in,
+               const size_t ite_in, const size_t itr_in,
                const double nps_in,
                const unsigned short int nms_in,
-               const std::vector<std::string> &mts_in,
+               const std::vector<size_t> &mid_in,
                const std::vector<double> &fps_in);
 
     /**
@@ -470,17 +1336,24 @@ public:
      */
     double operator [](const size_t ine) const;
 
+    /**
+     * @brief Flags whether operator[] increases monotonically with ine
+     * @return true, if all materials have monotone zbar rows
+     *         (see Database::zbar_row_monotone)
+     */
+    bool is_monotone() const;
+
 
 private:
     
     /// Pointer to parent Database object
     const Database *dp;
     
-    /// Reference to Table object
-    const Table &tbl;
-    
-    /// File-name root based on te, tr
-    std::string frt;
+    /// Electron temperature Database index
+    size_t ite;
+
+    /// Radiation temperature Database index
+    size_t itr;
     
     /// Total particle number density (particles/cm3)
     double nps;
@@ -488,11 +1361,17 @@ private:
     /// Number of materials
     unsigned short int nms;
     
-    /// Material IDs
-    std::vector<std::string> mts;
+    /// Material indices (see Database::material_index)
+    const std::vector<size_t> &mid;
     
     /// Fractional populations of materials
-    std::vector<double> fps;
+    const std::vector<double> &fps;
+
+    /// Preloaded zbars of each material along the ne grid
+    std::vector<const double *> zbr;
+
+    /// Monotonicity of operator[] in ine
+    bool mono;
 };
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,402 @@
+/**
+ * @file DbPack.cpp
+ * @brief Packed binary EOS/spectral Database file, accessed by memory map
+ * @author Peter Hakel
+ * @version 0.9
+ * @date Created on 16 October 2026\n
+ * Last modified on 17 October 2026
+ * @copyright (c) 2015, Triad National Security, LLC.
+ * All rights reserved.\n
+ * Use of this source code is governed by the BSD 3-Clause License.
+ * See top-level license.txt file for full license text.
+ */
+
+#include <DbPack.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+#ifndef WIN
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+/// Number of uint64_t words in the header, following the magic string
+const size_t NHEADER = 6;
+
+/// Ordering of DbPackEntry records by (mat, ite, itr, ine)
+bool entry_less(const DbPackEntry &a, const DbPackEntry &b)
+{
+    if (a.mat != b.mat) return a.mat < b.mat;
+    if (a.ite != b.ite) return a.ite < b.ite;
+    if (a.itr != b.itr) return a.itr < b.itr;
+    return a.ine < b.ine;
+}
+}
+
+//-----------------------------------------------------------------------------
+
+DbPack::DbPack(const std::string &fname_in):
+    fname(fname_in), base(nullptr), nbytes(0), buffer(),
+    nte(0), ntr(0), nne(0), nhv(0), nmat(0), nentries(0), mat(),
+    index(nullptr), data(nullptr)
+#ifdef MPI
+    , win(MPI_WIN_NULL)
+#endif
+{
+#ifdef MPI
+    int mpi_on = 0;
+    MPI_Initialized(&mpi_on);
+    if (mpi_on)
+        load_shared();
+    else
+        map_file();
+#else
+    map_file();
+#endif
+
+    const size_t nhead = MAGIC.size() + NHEADER * sizeof(uint64_t);
+    if (nbytes < nhead  ||  std::memcmp(base, MAGIC.data(), MAGIC.size()) != 0)
+    {
+        std::cerr << "Error: file " << fname << " is not a packed Database "
+                  << "in DbPack::DbPack" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    const uint64_t *h = reinterpret_cast<const uint64_t *>(base+MAGIC.size());
+    nte = static_cast<size_t>(h[0]);
+    ntr = static_cast<size_t>(h[1]);
+    nne = static_cast<size_t>(h[2]);
+    nhv = static_cast<size_t>(h[3]);
+    nmat = static_cast<size_t>(h[4]);
+    nentries = static_cast<size_t>(h[5]);
+
+    // handle table and index must fit, before either is read
+    size_t left = nbytes - nhead;
+    bool is_truncated = nmat > left / HANDLE_SIZE;
+    if (!is_truncated)
+    {
+        left -= nmat * HANDLE_SIZE;
+        is_truncated = nentries > left / sizeof(DbPackEntry);
+    }
+    if (is_truncated)
+    {
+        std::cerr << "Error: file " << fname << " is truncated "
+                  << "in DbPack::DbPack" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    const size_t ndata = (left - nentries * sizeof(DbPackEntry))
+                       / sizeof(double);
+
+    const char *q = base + nhead;
+    for (size_t i = 0; i < nmat; ++i)
+    {
+        mat.emplace_back(std::string(q, strnlen(q, HANDLE_SIZE)));
+        q += HANDLE_SIZE;
+    }
+    index = reinterpret_cast<const DbPackEntry *>(q);
+    q += nentries * sizeof(DbPackEntry);
+    data = reinterpret_cast<const double *>(q);
+
+    // every entry's zbar and spectra must lie within the data block
+    for (size_t i = 0; i < nentries; ++i)
+    {
+        const DbPackEntry &e = index[i];
+        const bool zb_out = e.zb != NONE  &&  e.zb >= ndata;
+        const bool sp_out = e.sp != NONE  &&
+                            (e.sp > ndata  ||  (ndata - e.sp) / 3 < nhv);
+        if (zb_out  ||  sp_out)
+        {
+            std::cerr << "Error: file " << fname << " is truncated (entry "
+                      << i << ") in DbPack::DbPack" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+DbPack::~DbPack()
+{
+#ifdef MPI
+    if (win != MPI_WIN_NULL)
+    {   // after MPI_Finalize the window is gone already
+        int mpi_done = 0;
+        MPI_Finalized(&mpi_done);
+        if (!mpi_done) MPI_Win_free(&win);
+        return;
+    }
+#endif
+#ifndef WIN
+    if (base != nullptr) munmap(const_cast<char *>(base), nbytes);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+void DbPack::map_file()
+{
+#ifdef WIN
+    std::ifstream infile(fname.c_str(), std::ios::binary);
+    if (!infile.is_open())
+    {
+        std::cerr << "Error: file " << fname << " is not open in "
+                  << "DbPack::map_file" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    buffer.assign(std::istreambuf_iterator<char>(infile),
+                  std::istreambuf_iterator<char>());
+    infile.close();
+    base = buffer.data();
+    nbytes = buffer.size();
+#else
+    int fd = open(fname.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        std::cerr << "Error: file " << fname << " is not open in "
+                  << "DbPack::map_file" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0  ||  st.st_size <= 0)
+    {
+        std::cerr << "Error: file " << fname << " cannot be sized in "
+                  << "DbPack::map_file" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    nbytes = static_cast<size_t>(st.st_size);
+    void *p = mmap(nullptr, nbytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)
+    {
+        std::cerr << "Error: file " << fname << " cannot be mapped in "
+                  << "DbPack::map_file" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    base = static_cast<const char *>(p);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef MPI
+void DbPack::load_shared()
+{
+    MPI_Comm node;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0,
+                        MPI_INFO_NULL, &node);
+    int node_rank;
+    MPI_Comm_rank(node, &node_rank);
+
+    // the loader rank sizes the file, and tells the others
+    std::ifstream infile;
+    uint64_t n = 0;
+    if (node_rank == 0)
+    {
+        infile.open(fname.c_str(), std::ios::binary | std::ios::ate);
+        if (infile.is_open()) n = static_cast<uint64_t>(infile.tellg());
+    }
+    MPI_Bcast(&n, 1, MPI_UINT64_T, 0, node);
+    if (n == 0)
+    {
+        std::cerr << "Error: file " << fname << " is not open in "
+                  << "DbPack::load_shared" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    nbytes = static_cast<size_t>(n);
+
+    // one allocation per node, made by the loader rank
+    char *p = nullptr;
+    MPI_Aint size = (node_rank == 0) ? static_cast<MPI_Aint>(nbytes) : 0;
+    MPI_Win_allocate_shared(size, 1, MPI_INFO_NULL, node, &p, &win);
+    if (node_rank != 0)
+    {
+        MPI_Aint qsize;
+        int qdisp;
+        MPI_Win_shared_query(win, 0, &qsize, &qdisp, &p);
+    }
+
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+    if (node_rank == 0)
+    {
+        infile.seekg(0);
+        infile.read(p, static_cast<std::streamsize>(nbytes));
+        infile.close();
+    }
+    MPI_Win_sync(win);
+    MPI_Barrier(node); // file contents are in place for all ranks
+    MPI_Win_sync(win);
+    MPI_Win_unlock_all(win);
+    MPI_Comm_free(&node);
+    base = p;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+
+std::string DbPack::get_fname() const
+{
+    return fname;
+}
+
+//-----------------------------------------------------------------------------
+
+bool DbPack::is_shared() const
+{
+#ifdef MPI
+    return win != MPI_WIN_NULL;
+#else
+    return false;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+size_t DbPack::get_nte() const
+{
+    return nte;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t DbPack::get_ntr() const
+{
+    return ntr;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t DbPack::get_nne() const
+{
+    return nne;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t DbPack::get_nhv() const
+{
+    return nhv;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t DbPack::get_nmat() const
+{
+    return nmat;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t DbPack::get_nentries() const
+{
+    return nentries;
+}
+
+//-----------------------------------------------------------------------------
+
+std::string DbPack::get_material(const size_t i) const
+{
+    return mat.at(i);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t DbPack::find_material(const std::string &m) const
+{
+    return static_cast<size_t>(std::find(mat.begin(), mat.end(), m)
+                               - mat.begin());
+}
+
+//-----------------------------------------------------------------------------
+
+const DbPackEntry * DbPack::find(const size_t imat, const size_t ite,
+                                 const size_t itr, const size_t ine) const
+{
+    DbPackEntry key;
+    key.mat = imat;
+    key.ite = ite;
+    key.itr = itr;
+    key.ine = ine;
+    const DbPackEntry *end = index + nentries;
+    const DbPackEntry *e = std::lower_bound(index, end, key, entry_less);
+    if (e == end  ||  entry_less(key, *e)) return nullptr;
+    return e;
+}
+
+//-----------------------------------------------------------------------------
+
+const double * DbPack::get_zbar(const size_t imat, const size_t ite,
+                                const size_t itr, const size_t ine) const
+{
+    const DbPackEntry *e = find(imat, ite, itr, ine);
+    if (e == nullptr  ||  e->zb == NONE) return nullptr;
+    return data + e->zb;
+}
+
+//-----------------------------------------------------------------------------
+
+const double * DbPack::get_spectra(const size_t imat, const size_t ite,
+                                   const size_t itr, const size_t ine) const
+{
+    const DbPackEntry *e = find(imat, ite, itr, ine);
+    if (e == nullptr  ||  e->sp == NONE) return nullptr;
+    return data + e->sp;
+}
+
+//-----------------------------------------------------------------------------
+
+void DbPack::write(const std::string &fname,
+                   const size_t nte, const size_t ntr,
+                   const size_t nne, const size_t nhv,
+                   const std::vector<std::string> &mat,
+                   const std::vector<DbPackEntry> &entry,
+                   const std::vector<double> &data)
+{
+    std::ofstream outfile(fname.c_str(), std::ios::binary);
+    if (!outfile.is_open())
+    {
+        std::cerr << "Error: file " << fname << " is not open in "
+                  << "DbPack::write" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    outfile.write(MAGIC.data(), static_cast<std::streamsize>(MAGIC.size()));
+    const uint64_t h[NHEADER] = {nte, ntr, nne, nhv, mat.size(), entry.size()};
+    outfile.write(reinterpret_cast<const char *>(h), sizeof(h));
+    for (auto &m : mat)
+    {
+        if (m.size() >= HANDLE_SIZE)
+        {
+            std::cerr << "Error: material file handle " << m << " is too "
+                      << "long in DbPack::write" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        std::vector<char> s(HANDLE_SIZE, '\0');
+        std::copy(m.begin(), m.end(), s.begin());
+        outfile.write(s.data(), static_cast<std::streamsize>(HANDLE_SIZE));
+    }
+    outfile.write(reinterpret_cast<const char *>(entry.data()),
+        static_cast<std::streamsize>(entry.size() * sizeof(DbPackEntry)));
+    outfile.write(reinterpret_cast<const char *>(data.data()),
+        static_cast<std::streamsize>(data.size() * sizeof(double)));
+    outfile.close();
+    outfile.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+const uint64_t DbPack::NONE = std::numeric_limits<uint64_t>::max();
+const size_t DbPack::HANDLE_SIZE = 16;
+const std::string DbPack::MAGIC = "FESTRDB1";
+
+//-----------------------------------------------------------------------------
+
+//  end DbPack.cpp
@@ -0,0 +1,276 @@
+#ifndef LANL_ASC_PEM_DBPACK_H_
+#define LANL_ASC_PEM_DBPACK_H_
+
+/**
+ * @file DbPack.h
+ * @brief Packed binary EOS/spectral Database file, accessed by memory map
+ * @author Peter Hakel
+ * @version 0.9
+ * @date Created on 16 October 2026\n
+ * Last modified on 16 October 2026
+ * @copyright (c) 2015, Triad National Security, LLC.
+ * All rights reserved.\n
+ * Use of this source code is governed by the BSD 3-Clause License.
+ * See top-level license.txt file for full license text.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifdef MPI
+#include <mpi.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+/** @brief One record in the index of a DbPack file
+ *
+ * Offsets count doubles from the start of the data block;
+ * DbPack::NONE marks data that are absent from the text Database
+ */
+struct DbPackEntry
+{
+    /// Material index (position in the material list of the DbPack file)
+    uint64_t mat;
+
+    /// Electron temperature Database index
+    uint64_t ite;
+
+    /// Radiation temperature Database index
+    uint64_t itr;
+
+    /// Electron number density Database index
+    uint64_t ine;
+
+    /// Offset of the average ionization (one double)
+    uint64_t zb;
+
+    /// Offset of em, ab, sc spectra (3 * nhv doubles, in that order)
+    uint64_t sp;
+};
+
+//-----------------------------------------------------------------------------
+
+/** @brief Read-only view of a packed Database file
+ *
+ * Layout (native byte order):\n
+ * magic string (8 bytes), nte, ntr, nne, nhv, nmat, nentries (uint64_t),\n
+ * nmat material file handles (DbPack::HANDLE_SIZE bytes each),\n
+ * nentries DbPackEntry records sorted by (mat, ite, itr, ine),\n
+ * data block of doubles\n
+ * In MPI runs the file is read once per node, into an MPI-3 shared-memory
+ * window that all ranks on the node read in place
+ */
+class DbPack
+{
+public:
+
+    /**
+     * @brief Parametrized constructor: maps the file into memory
+     * @param[in] fname Name of the packed Database file
+     */
+    explicit DbPack(const std::string &fname);
+
+    /**
+     * @brief Copy constructor
+     * @param[in] o DbPack object to be copied (deleted, owns the mapping)
+     */
+    DbPack(const DbPack &o) = delete;
+
+    /**
+     * @brief Overloaded assignment operator
+     * @param[in] o DbPack object to be copied (deleted, owns the mapping)
+     * @return Reference to copied object
+     */
+    DbPack &operator=(const DbPack &o) = delete;
+
+    /// Destructor: releases the memory map (or the shared-memory window)
+    ~DbPack();
+
+    /**
+     * @brief Getter for the name of the packed file (DbPack::fname)
+     * @return Name of the packed file
+     */
+    std::string get_fname() const;
+
+    /**
+     * @brief Flags whether the file is held in a node-level shared-memory
+     *        window (MPI runs)
+     * @return true, if the file contents are shared by the ranks of a node
+     */
+    bool is_shared() const;
+
+    /**
+     * @brief Getter for number of points in electron temperature grid
+     * @return Number of points in electron temperature grid
+     */
+    size_t get_nte() const;
+
+    /**
+     * @brief Getter for number of points in radiation temperature grid
+     * @return Number of points in radiation temperature grid
+     */
+    size_t get_ntr() const;
+
+    /**
+     * @brief Getter for number of points in electron number density grid
+     * @return Number of points in electron number density grid
+     */
+    size_t get_nne() const;
+
+    /**
+     * @brief Getter for number of points in photon energy grid
+     * @return Number of points in photon energy grid
+     */
+    size_t get_nhv() const;
+
+    /**
+     * @brief Getter for number of materials
+     * @return Number of materials
+     */
+    size_t get_nmat() const;
+
+    /**
+     * @brief Getter for number of index records
+     * @return Number of (mat, ite, itr, ine) records
+     */
+    size_t get_nentries() const;
+
+    /**
+     * @brief Getter for material file handle
+     * @param[in] i Material index
+     * @return Material file handle
+     */
+    std::string get_material(const size_t i) const;
+
+    /**
+     * @brief Locates a material in the packed file
+     * @param[in] m Material file handle (from Table::get_F)
+     * @return Material index; get_nmat(), if m is not in the packed file
+     */
+    size_t find_material(const std::string &m) const;
+
+    /**
+     * @brief Average ionization at one Database grid point
+     * @param[in] imat Material index
+     * @param[in] ite Electron temperature Database index
+     * @param[in] itr Radiation temperature Database index
+     * @param[in] ine Electron number density Database index
+     * @return Pointer to zbar; nullptr, if not present
+     */
+    const double * get_zbar(const size_t imat, const size_t ite,
+                            const size_t itr, const size_t ine) const;
+
+    /**
+     * @brief Spectra at one Database grid point
+     * @param[in] imat Material index
+     * @param[in] ite Electron temperature Database index
+     * @param[in] itr Radiation temperature Database index
+     * @param[in] ine Electron number density Database index
+     * @return Pointer to em[0]; ab and sc follow at offsets nhv and 2*nhv;
+     *         nullptr, if not present
+     */
+    const double * get_spectra(const size_t imat, const size_t ite,
+                               const size_t itr, const size_t ine) const;
+
+    /**
+     * @brief Writes a packed file
+     * @param[in] fname Name of the packed file to be written
+     * @param[in] nte Number of points in electron temperature grid
+     * @param[in] ntr Number of points in radiation temperature grid
+     * @param[in] nne Number of points in electron number density grid
+     * @param[in] nhv Number of points in photon energy grid
+     * @param[in] mat Material file handles
+     * @param[in] entry Index records, sorted by (mat, ite, itr, ine),
+     *            with offsets into data
+     * @param[in] data Data block
+     */
+    static void write(const std::string &fname,
+                      const size_t nte, const size_t ntr,
+                      const size_t nne, const size_t nhv,
+                      const std::vector<std::string> &mat,
+                      const std::vector<DbPackEntry> &entry,
+                      const std::vector<double> &data);
+
+    /// Marks an absent offset in DbPackEntry
+    static const uint64_t NONE;
+
+    /// Size of a material file handle record (bytes)
+    static const size_t HANDLE_SIZE;
+
+    /// Magic string at the start of a packed file
+    static const std::string MAGIC;
+
+
+private:
+
+    /// Name of the packed file
+    std::string fname;
+
+    /// Start of the mapped file
+    const char *base;
+
+    /// Size of the mapped file (bytes)
+    size_t nbytes;
+
+    /// File contents, if memory mapping is not available
+    std::vector<char> buffer;
+
+    /// Number of points in electron temperature grid
+    size_t nte;
+
+    /// Number of points in radiation temperature grid
+    size_t ntr;
+
+    /// Number of points in electron number density grid
+    size_t nne;
+
+    /// Number of points in photon energy grid
+    size_t nhv;
+
+    /// Number of materials
+    size_t nmat;
+
+    /// Number of index records
+    size_t nentries;
+
+    /// Material file handles
+    std::vector<std::string> mat;
+
+    /// Start of the index records within the mapped file
+    const DbPackEntry *index;
+
+    /// Start of the data block within the mapped file
+    const double *data;
+
+#ifdef MPI
+    /// Node-level shared-memory window holding the file contents
+    MPI_Win win;
+
+    /**
+     * @brief Reads the file into a node-level MPI-3 shared-memory window;
+     *        rank 0 of each node reads, the other ranks query its address
+     *        (collective over MPI_COMM_WORLD)
+     */
+    void load_shared();
+#endif
+
+    /// Maps the file into memory (reads it into DbPack::buffer on Windows)
+    void map_file();
+
+    /**
+     * @brief Locates an index record
+     * @param[in] imat Material index
+     * @param[in] ite Electron temperature Database index
+     * @param[in] itr Radiation temperature Database index
+     * @param[in] ine Electron number density Database index
+     * @return Pointer to the record; nullptr, if not present
+     */
+    const DbPackEntry * find(const size_t imat, const size_t ite,
+                             const size_t itr, const size_t ine) const;
+};
+
+//-----------------------------------------------------------------------------
+
+#endif  // LANL_ASC_PEM_DBPACK_H_
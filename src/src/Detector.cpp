@@ -4,7 +4,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 28 January 2015\n
- * Last modified on 3 March 2023
+ * Last modified on 17 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -343,6 +343,7 @@ void do_patch(const PatchID &pid, PatchSpectrum &pout)
     }
     Progress counter(this_det->dname + "_Ray", next_level, nrays, next_freq,
                      SEP, std::cout);
+    this_det->sync_paths(*m);
 
     this_det->yp[patch].fill(0.0);
     std::string cname(this_det->dname + "-yp" + this_det->patch_fname(patch));
@@ -353,22 +354,28 @@ void do_patch(const PatchID &pid, PatchSpectrum &pout)
 
     #ifdef _OPENMP
     omp_set_num_threads(glob::nthreads);
-    #pragma omp parallel for default(none) \
+    #pragma omp parallel default(none) \
      firstprivate(this_det,gol,tname,header,cname,tbl,d,m,g,patch,it,nrays,ndims) \
      shared(counter)
     #endif
+    {
+    ChordPath buf; // path buffer reused by all Rays of this thread
+    #ifdef _OPENMP
+    #pragma omp for
+    #endif
     for (size_t itheta_iphi = 0; itheta_iphi < nrays; ++itheta_iphi)
     {
         auto itheta_iphi_pair = utils::one_to_two(ndims, itheta_iphi);
         size_t itheta = itheta_iphi_pair.first;
         size_t iphi = itheta_iphi_pair.second;
         this_det->do_Ray(&counter, patch, IntPair(itheta, iphi), *g, *m, *d, *tbl,
-                         it, cname, header, tname, *gol);
+                         it, cname, header, tname, *gol, buf);
         #ifdef _OPENMP
         #pragma omp critical
         #endif
         {counter.advance();}
     }
+    } // end parallel region
 
     if (this_det->ntheta > 0) // (W/eV); (W/cm2/sr/eV) for ntheta == 0
     {
@@ -458,7 +465,8 @@ Detector::Detector(): yt(), yst(),
     back_value(-9.0), yback(), trad(), tracking(false), write_Ray(true),
     nx(0), ny(0), nxd(0), nyd(0),
     pc(), theta_max(0.0), ntheta(0), nphi(0), nthetad(0), nphid(0),
-    dtheta(0.0), dtheta2(0.0), gdet(), p(), yp(), ys()
+    dtheta(0.0), dtheta2(0.0), gdet(), p(), yp(), ys(), hv_mono(), bands(),
+    band_id(SIZE_MAX), paths(), paths_hash(0)
     {}
 
 //-----------------------------------------------------------------------------
@@ -486,7 +494,8 @@ Detector::Detector(const size_t freq_patch_in, const size_t freq_Ray_in,
     back_fname(""), back_value(-9.0), yback(), trad(), tracking(tracking_in),
     write_Ray(write_Ray_in), nx(0), ny(0), nxd(0), nyd(0), pc(pc_in),
     theta_max(0.0), ntheta(0), nphi(0), nthetad(0), nphid(0), dtheta(0.0),
-    dtheta2(0.0), gdet(), p(), yp(), ys()
+    dtheta2(0.0), gdet(), p(), yp(), ys(), hv_mono(), bands(),
+    band_id(SIZE_MAX), paths(), paths_hash(0)
 {
     // set hv grid
     std::string hvpath(dbase_path + "grids/hv_grid.txt");
@@ -644,7 +653,102 @@ Detector::Detector(const size_t freq_patch_in, const size_t freq_Ray_in,
     }
 
     // write out the working backlighter spectrum
-    hvpath = path_in + dname_in + "-hv_grid.txt";
+    write_grid_files();
+}
+
+//-----------------------------------------------------------------------------
+
+void Detector::set_bands(const Database &d, const std::string &weight,
+                         const std::vector<double> &lo,
+                         const std::vector<double> &hi)
+{
+    if (d.get_tops_cmnd() != "none")
+    {
+        std::cerr << "Error: bands of Detector " << dname << " require "
+                  << "TOPS_command none" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    BandSet b;
+    b.weight = weight;
+    std::vector<double> hvb; // band centers
+    for (size_t k = 0; k < lo.size(); ++k)
+    {
+        size_t klo(nhv), khi(0);
+        for (size_t i = 0; i < nhv; ++i)
+            if (hv.at(i) >= lo.at(k)  &&  hv.at(i) <= hi.at(k))
+            {
+                klo = std::min(klo, i);
+                khi = std::max(khi, i);
+            }
+        if (klo > khi)
+        {
+            std::cerr << "Error: band " << lo.at(k) << " " << hi.at(k)
+                      << " eV of Detector " << dname << " holds no point "
+                      << "of its hv grid" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        b.jlo.push_back(jmin + klo);
+        b.jhi.push_back(jmin + khi);
+        hvb.push_back(0.5 * (hv.at(klo) + hv.at(khi)));
+    }
+    band_id = d.band_index(b);
+    bands = b;
+
+    // from here on, the spectral arrays of *this Detector hold one value
+    // per band
+    hv_mono = hv;
+    yback = band_average(yback);
+    hv = hvb;
+    nhv = hv.size();
+    fwhm = -1.0; // no instrumental broadening on the band grid
+    for (auto &y : yt) y.second.assign(nhv, 0.0);
+    for (auto &y : yp) y.second.assign(nhv, 0.0);
+    ys.assign(nhv, 0.0);
+    yst.assign(nhv, 0.0);
+    write_grid_files();
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Detector::get_band_id() const
+{
+    return band_id;
+}
+
+//-----------------------------------------------------------------------------
+
+BandSet Detector::get_bands() const
+{
+    return bands;
+}
+
+//-----------------------------------------------------------------------------
+
+std::vector<double> Detector::band_average(const std::vector<double> &y)
+    const
+{
+    std::vector<double> yb(bands.size(), 0.0);
+    for (size_t k = 0; k < bands.size(); ++k)
+    {
+        const size_t klo = bands.jlo.at(k) - jmin;
+        const size_t khi = bands.jhi.at(k) - jmin;
+        std::vector<double> w = Database::band_weights(hv_mono, klo, khi);
+        double sw(0.0), swy(0.0);
+        for (size_t i = 0; i < w.size(); ++i)
+        {
+            sw += w.at(i);
+            swy += w.at(i) * y.at(klo + i);
+        }
+        yb.at(k) = swy / sw;
+    }
+    return yb;
+}
+
+//-----------------------------------------------------------------------------
+
+void Detector::write_grid_files() const
+{
+    std::string hvpath = path + dname + "-hv_grid.txt";
     std::ofstream out_hv(hvpath.c_str());
     if (!out_hv.is_open())
     {
@@ -654,14 +758,14 @@ Detector::Detector(const size_t freq_patch_in, const size_t freq_Ray_in,
     out_hv << "\n Number of bits:\n           0\n\n Number of grid points:\n"
            << utils::int_to_string(nhv, ' ', cnst::INT_WIDTH+1)
            << "\n\n Grid points:\n";
-    std::string backpath = path_in + dname_in + "-backlighter.txt";
+    std::string backpath = path + dname + "-backlighter.txt";
     std::ofstream out_back(backpath.c_str());
     if (!out_back.is_open())
     {
         std::cerr << "Error: file " << backpath << " is not open." << std::endl;
         exit(EXIT_FAILURE);
     }
-    out_back << dname_in + "-backlighter\ndata in W/cm2/sr/eV" << std::endl;
+    out_back << dname + "-backlighter\ndata in W/cm2/sr/eV" << std::endl;
     for (size_t ihv = 0; ihv < nhv; ++ihv)
     {
         out_hv << utils::int_to_string(ihv, ' ', cnst::INT_WIDTH+1) << "  "
@@ -1014,12 +1118,31 @@ Vector3d Detector::local_to_global(const Vector3d &v) const
 
 //-----------------------------------------------------------------------------
 
+void Detector::sync_paths(const Mesh &m)
+{
+    if (m.get_geo_hash() != paths_hash)
+    {
+        paths.clear();
+        paths_hash = m.get_geo_hash();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Detector::get_npaths() const
+{
+    return paths.size();
+}
+
+//-----------------------------------------------------------------------------
+
 void Detector::do_Ray(Progress *parent,
                       const IntPair &patch, const IntPair &direction,
                       const Grid &g, const Mesh &m, const Database &d,
                       const Table &tbl, const size_t it,
                       const std::string &froot, const std::string &hroot,
-                      const std::string &tname, Goal &gol)
+                      const std::string &tname, Goal &gol,
+                      ChordPath &buf)
 {
     const size_t &ix = patch.first;
     const size_t &iy = patch.second;
@@ -1036,9 +1159,9 @@ void Detector::do_Ray(Progress *parent,
     Vector3d cvec(local_to_global(-cnst::CV * Vector3d(theta, phi)));
 
     const double EQT = 1.0e-15;
-    auto f = m.get_zone(Zone::BOUNDING_ZONE)->get_face(0);
+    const Face &f = m.zone_at(Zone::BOUNDING_ZONE).face_at(0);
     FaceID fid(Zone::BOUNDING_ZONE, -3);
-    RetIntercept pt = f->intercept(g, r0, cvec, EQT, fid);
+    RetIntercept pt = f.intercept(g, r0, cvec, EQT, fid);
 
     // set up Progress counter
     int next_level;
@@ -1066,15 +1189,50 @@ void Detector::do_Ray(Progress *parent,
         ray.diag_id = my_id;
         ray.patch_id = patch;
         ray.bundle_id = direction;
-        ray.trace(g, m);
+        ray.band_id = band_id;
+        ray.path.swap(buf); // reuse the capacity of earlier Rays' paths
+        if (paths_hash == 0)
+            ray.trace(g, m);
+        else // reuse the path traced in an earlier time step, if any
+        {   // the lock covers the map only; cached paths are immutable
+            const std::pair<IntPair, IntPair> key(patch, direction);
+            std::shared_ptr<const RayPath> rp;
+            #ifdef _OPENMP
+            #pragma omp critical (detector_paths)
+            #endif
+            {
+                auto ip = paths.find(key);
+                if (ip != paths.end()) rp = ip->second;
+            }
+            if (rp)
+                ray.set_path(*rp);
+            else
+            {
+                ray.trace(g, m);
+                rp = std::make_shared<const RayPath>(ray.get_path());
+                #ifdef _OPENMP
+                #pragma omp critical (detector_paths)
+                #endif
+                {paths[key] = rp;}
+            }
+        }
         if (back_type == "history")
         {
             double t_rad = trad[it];
-            for (size_t ihv = 0; ihv < nhv; ++ihv)
-                yback[ihv] = utils::planckian(hv.at(ihv), t_rad);
+            if (band_id != SIZE_MAX)
+            {
+                std::vector<double> ymono(hv_mono.size());
+                for (size_t ihv = 0; ihv < hv_mono.size(); ++ihv)
+                    ymono[ihv] = utils::planckian(hv_mono.at(ihv), t_rad);
+                yback = band_average(ymono);
+            }
+            else
+                for (size_t ihv = 0; ihv < nhv; ++ihv)
+                    yback[ihv] = utils::planckian(hv.at(ihv), t_rad);
         }
         ray.set_backlighter(yback);
         ray.cross_Mesh(m, d, tbl, symmetry, ix);
+        ray.path.swap(buf); // empty, after cross_Mesh
         if (ntheta == 0) // parallel Rays; one Ray per patch (W/cm2/sr/eV)
             yp[patch] = ray.y;
         else // bundle of Rays per patch (W/cm2/eV)
@@ -1151,6 +1309,7 @@ void Detector::do_patch(Progress *parent, const IntPair &patch,
     }
     Progress counter(dname + "_Ray", next_level, nrays, next_freq,
                      SEP, std::cout);
+    sync_paths(m);
 
     yp[patch].fill(0.0);
     std::string cname(dname + "-yp" + patch_fname(patch));
@@ -1158,8 +1317,9 @@ void Detector::do_patch(Progress *parent, const IntPair &patch,
     std::string tname(time_fname(it, ntd));
     std::string header(time_string(it, ntd, t));
     header += patch_string(patch);
+    ChordPath buf; // path buffer reused by all Rays of this patch
     do_Ray(&counter, patch, INT_PAIR_00, g, m, d, tbl, it,
-           cname, header, tname, gol);
+           cname, header, tname, gol, buf);
     counter.advance();
 
     for (size_t itheta_iphi = 0; itheta_iphi < nrays; ++itheta_iphi)
@@ -1168,7 +1328,7 @@ void Detector::do_patch(Progress *parent, const IntPair &patch,
         size_t itheta = itheta_iphi_pair.first;
         size_t iphi = itheta_iphi_pair.second;
         do_Ray(&counter, patch, IntPair(itheta, iphi), g, m, d, tbl,
-               it, cname, header, tname, gol);
+               it, cname, header, tname, gol, buf);
         counter.advance();
     }
 
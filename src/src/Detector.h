@@ -7,7 +7,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 28 January 2015\n
- * Last modified on 27 July 2022
+ * Last modified on 17 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -32,6 +32,7 @@ pmh_2015_0210
 #include <Vector3d.h>
 
 #include <map>
+#include <memory>
 #include <string>
 
 //-----------------------------------------------------------------------------
@@ -122,6 +123,33 @@ public:
     void set_bundle(const double theta_max_in,
                     const size_t ntheta_in, const size_t nphi_in);
 
+    /**
+     * @brief Switches *this Detector to band-averaged (multigroup) mode:
+     *        Rays carry one value per band (W/cm2/sr/eV averaged over the
+     *        band), with band-averaged optical data from Database::get_bands;
+     *        Detector::hv becomes the band centers, and no instrumental
+     *        broadening is applied; requires TOPS_command none
+     * @param[in] d Database (the bands are registered there)
+     * @param[in] weight Weight of the opacity means: "planck" or "rosseland"
+     * @param[in] lo Lower photon energy limit of each band (eV)
+     * @param[in] hi Upper photon energy limit of each band (eV)
+     */
+    void set_bands(const Database &d, const std::string &weight,
+                   const std::vector<double> &lo,
+                   const std::vector<double> &hi);
+
+    /**
+     * @brief Getter for Detector::band_id
+     * @return BandSet index in the Database; SIZE_MAX, if not band-averaged
+     */
+    size_t get_band_id() const;
+
+    /**
+     * @brief Getter for Detector::bands
+     * @return Bands as hv-grid index ranges of the Database
+     */
+    BandSet get_bands() const;
+
     /**
      * @brief Getter for Detector::dname
      * @return *this Detector's name
@@ -368,6 +396,19 @@ public:
      */
     Vector3d local_to_global(const Vector3d &v) const;
 
+    /**
+     * @brief Keeps the cached Ray paths (Detector::paths) if the Mesh
+     *        geometry is unchanged since the last call, clears them otherwise
+     * @param[in] m Reference to the current Mesh object
+     */
+    void sync_paths(const Mesh &m);
+
+    /**
+     * @brief Getter for the number of cached Ray paths
+     * @return Size of Detector::paths
+     */
+    size_t get_npaths() const;
+
     /**
      * @brief Create and transport an individual Ray
      * @param[in] parent Pointer to the previous level's Progress object
@@ -382,13 +423,15 @@ public:
      * @param[in] hroot Root of the file header for the current spatial patch
      * @param[in] tname Root of the filename for the current time interval
      * @param[in] gol Reference to the current Goal object
+     * @param[in,out] buf Empty Ray path buffer of the calling thread, reused
+     *                for its Rays to avoid allocations (Ray::path)
      */
     void do_Ray(Progress *parent,
                 const IntPair &patch, const IntPair &direction,
                 const Grid &g, const Mesh &m, const Database &d,
                 const Table &tbl, const size_t it,
                 const std::string &froot, const std::string &hroot,
-                const std::string &tname, Goal &gol);
+                const std::string &tname, Goal &gol, ChordPath &buf);
 
     /**
      * @brief Transport all Rays for the given spatial patch of *this Detector
@@ -654,6 +697,33 @@ public:
 
     /// Space-integrated, time-resolved spectrum
     ArrDbl ys;
+
+    /// Photon energy grid (eV) within the range, kept in band-averaged mode
+    std::vector<double> hv_mono;
+
+    /// Bands as hv-grid index ranges of the Database (set_bands)
+    BandSet bands;
+
+    /// BandSet index in the Database; SIZE_MAX, if not band-averaged
+    size_t band_id;
+
+    /// Traced Ray paths by (patch, direction), valid for Detector::paths_hash;
+    /// shared and immutable, so that Rays copy them outside of the lock
+    std::map<std::pair<IntPair, IntPair>, std::shared_ptr<const RayPath>>
+        paths;
+
+    /// Mesh::get_geo_hash for Detector::paths (0: no caching)
+    uint64_t paths_hash;
+
+    /**
+     * @brief Averages a spectrum given on Detector::hv_mono over the bands
+     * @param[in] y Spectrum on Detector::hv_mono
+     * @return One value per band
+     */
+    std::vector<double> band_average(const std::vector<double> &y) const;
+
+    /// Writes the working hv grid and backlighter spectrum to files
+    void write_grid_files() const;
 };
 
 //-----------------------------------------------------------------------------
@@ -4,7 +4,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 5 February 2015\n
- * Last modified on 29 April 2022
+ * Last modified on 17 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -19,14 +19,18 @@ Diagnostics.cpp
 
 #include <Diagnostics.h>
 
+#include <PipeProvider.h>
 #include <Progress.h>
 #include <Vector3d.h>
 #include <utils.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <thread>
 
 #ifdef MPI
 #include <mpi.h>
@@ -34,8 +38,8 @@ Diagnostics.cpp
 
 //-----------------------------------------------------------------------------
 
-Diagnostics::Diagnostics(): level(0), freq(0), path(""), outpath(""), det()
-{}
+Diagnostics::Diagnostics(): level(0), freq(0), path(""), outpath(""), det(),
+    prefetch(false) {}
 
 //-----------------------------------------------------------------------------
 
@@ -44,7 +48,8 @@ Diagnostics::Diagnostics(const int level_in,
                          const std::string &hydro_path,
                          const std::string &out_path,
                          const Database &d):
-    level(level_in), freq(0), path(diag_path), outpath(""), det()
+    level(level_in), freq(0), path(diag_path), outpath(""), det(),
+    prefetch(false)
 {
     std::string fname(hydro_path + "times.txt");
     std::string times_string(utils::file_to_string(fname));
@@ -152,6 +157,19 @@ Diagnostics::Diagnostics(const int level_in,
         indet >> write_Ray_str;
         bool write_Ray(utils::string_to_bool(write_Ray_str));
 
+        std::string band_weight("");
+        std::vector<double> band_lo, band_hi;
+        if (utils::find_word_opt(indet, "bands")) // band-averaged mode
+        {
+            size_t nband(0);
+            std::string unit;
+            indet >> nband >> band_weight;
+            band_lo.resize(nband);
+            band_hi.resize(nband);
+            for (size_t k = 0; k < nband; ++k)
+                indet >> band_lo.at(k) >> band_hi.at(k) >> unit;
+        }
+
         indet.close();
         indet.clear();
 
@@ -168,6 +186,8 @@ Diagnostics::Diagnostics(const int level_in,
         }
         if (theta_max <= 0.0) theta_max = detctr.compute_theta_max(sc, sr);
         detctr.set_bundle(theta_max, ntheta, nphi);
+        if (!band_lo.empty())
+            detctr.set_bands(d, band_weight, band_lo, band_hi);
         det.emplace_back(std::move(detctr));
 
         fname = outpath + "times.txt";
@@ -225,12 +245,40 @@ void Diagnostics::postprocess(const Database &d, const Hydro &h, Goal &gol)
 
     { // begin block defining Progress diag_counter scope
     Progress diag_counter(name, level, nintervals, freq, DIAGSEP, std::cout);
+
+    // union of the hv ranges of all Detectors, for the Zone opacity stage
+    size_t jmin, jmax;
+    hv_range(d, jmin, jmax);
+    const bool mix = (d.get_tops_cmnd() == "none"  &&  jmin <= jmax);
+    std::shared_ptr<OpacityProvider> op = opacity_provider(d, jmin, jmax);
+
+    // next time step, read in the background while the current one runs
+    Grid g_next;
+    Mesh m_next;
+    std::thread reader;
+
     for (size_t j = 0; j < nintervals; ++j) // loop over time
     {
         size_t it = h.time_index_at(j);
         double t = h.time_at(it);
         double dt = h.dt_at(it);
-        h.load_at(it, g, m);
+        if (reader.joinable())
+        {
+            reader.join();
+            std::swap(g, g_next);
+            std::swap(m, m_next);
+        }
+        else
+            h.load_at(it, g, m);
+        if (prefetch  &&  mix  &&  !d.is_packed()  &&  j+1 < nintervals)
+        {
+            size_t it_next = h.time_index_at(j+1);
+            reader = std::thread([&, it_next]()
+                {prefetch_step(d, h, tbl, it_next, jmin, jmax,
+                               g_next, m_next);});
+        }
+        if (mix) m.mix_spectra(d, tbl, jmin, jmax); // once for all Rays
+        if (op) m.provide_spectra(*op, tbl); // one round trip per time step
         Progress det_counter("Detector", level+1, ndet,                          diag_counter.get_next_freq(freq_det), DETSEP, std::cout);
         for (size_t id = 0; id < ndet; ++id) // loop over Detectors
         {
@@ -240,6 +288,7 @@ void Diagnostics::postprocess(const Database &d, const Hydro &h, Goal &gol)
         }
         diag_counter.advance();
     } // end loop over time
+    if (op) std::cout << "\n" << op->to_string() << std::endl;
     } // end block defining Progress diag_counter scope
 
     #ifdef MPI
@@ -295,6 +344,106 @@ void Diagnostics::postprocess(const Database &d, const Hydro &h, Goal &gol)
 
 //-----------------------------------------------------------------------------
 
+void Diagnostics::prefetch_step(const Database &d, const Hydro &h,
+                                const Table &tbl, const size_t it,
+                                const size_t jmin, const size_t jmax,
+                                Grid &g, Mesh &m) const
+{
+    h.load_at(it, g, m);
+    ArrDbl em, ab, sc;
+    for (size_t i = 0; i < m.size(); ++i)
+    {
+        ZonePtr z = m.get_zone(i);
+        unsigned short int nmat = z->get_nmat();
+        if (nmat == 0) continue;
+        const std::vector<size_t> mid = d.material_index(tbl, nmat,
+                                                         z->get_mat());
+        size_t ite(0), itr(0), ine(0);
+        d.find_ne(z->get_te(), ite, z->get_tr(), itr, z->get_np(),
+                  nmat, mid, z->get_fp(), ine);
+        for (unsigned short int k = 0; k < nmat; ++k)
+            d.get_spectra(mid[k], ite, itr, ine, jmin, jmax, em, ab, sc);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void Diagnostics::hv_range(const Database &d, size_t &jmin, size_t &jmax) const
+{
+    jmin = d.get_nhv();
+    jmax = 0;
+    for (auto &di : det)
+    {
+        if (di.get_band_id() != SIZE_MAX) continue; // Database::get_bands
+        jmin = std::min(jmin, di.get_jmin());
+        jmax = std::max(jmax, di.get_jmax());
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+std::shared_ptr<OpacityProvider> Diagnostics::opacity_provider(
+    const Database &d, const size_t jmin, const size_t jmax) const
+{
+    if (d.get_tops_cmnd() == "none"  ||  jmin > jmax) return nullptr;
+    return std::make_shared<PipeProvider>(d.get_tops_cmnd(), jmin, jmax);
+}
+
+//-----------------------------------------------------------------------------
+
+void Diagnostics::walk_lookups(const Database &d, const Hydro &h,
+    const std::function<void(const std::string &, size_t, size_t, size_t)>
+        &f) const
+{
+    Grid g;
+    Mesh m;
+    const Table &tbl = h.get_table();
+    for (size_t j = 0; j < h.get_nintervals(); ++j) // same Zone states and
+    {                                               // lookups as postprocess()
+        h.load_at(h.time_index_at(j), g, m);
+        for (size_t i = 0; i < m.size(); ++i)
+        {
+            ZonePtr z = m.get_zone(i);
+            unsigned short int nmat = z->get_nmat();
+            if (nmat == 0) continue;
+            size_t ite(0), itr(0), ine(0);
+            d.find_ne(tbl, z->get_te(), ite, z->get_tr(), itr, z->get_np(),
+                      nmat, z->get_mat(), z->get_fp(), ine);
+            for (unsigned short int k = 0; k < nmat; ++k)
+                f(tbl.get_F(z->mat_at(k)), ite, itr, ine);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+DbSubset Diagnostics::subset(const Database &d, const Hydro &h) const
+{
+    DbSubset s;
+    for (auto &deti : det)
+    {
+        s.jmin = std::min(s.jmin, deti.get_jmin());
+        s.jmax = std::max(s.jmax, deti.get_jmax());
+    }
+    walk_lookups(d, h, [&s](const std::string &mat, size_t ite, size_t itr,
+                            size_t ine) {s.add(mat, ite, itr, ine);});
+    return s;
+}
+
+//-----------------------------------------------------------------------------
+
+std::set<SpecKey> Diagnostics::lookups(const Database &d,
+                                       const Hydro &h) const
+{
+    std::set<SpecKey> keys;
+    walk_lookups(d, h, [&d, &keys](const std::string &mat, size_t ite,
+                                   size_t itr, size_t ine)
+        {keys.insert(SpecKey(d.material_index(mat), ite, itr, ine));});
+    return keys;
+}
+
+//-----------------------------------------------------------------------------
+
 void Diagnostics::analyze(const Database &d, Hydro &h, Goal &gol)
 {
     #include <diag_exec.inc>
@@ -303,6 +452,9 @@ void Diagnostics::analyze(const Database &d, Hydro &h, Goal &gol)
     size_t current_zone;
     size_t previous_zone = n;
     std::string name("Case");
+    size_t jmin, jmax;
+    hv_range(d, jmin, jmax);
+    std::shared_ptr<OpacityProvider> op = opacity_provider(d, jmin, jmax);
 
     { // begin block defining Progress diag_counter scope
     Progress diag_counter(name, level, nintervals, freq, DIAGSEP, std::cout);
@@ -332,12 +484,16 @@ void Diagnostics::analyze(const Database &d, Hydro &h, Goal &gol)
                     previous_zone = current_zone;
                 }
             }
+            m.intern_mat(d, tbl);
+            if (op) m.provide_spectra(*op, tbl);
             det.at(0).evaluate(ndim, g, m, d, tbl, jt, t, dt, ntd, gol);
             }
 
         else // "symmetry == none" path
         {
             h.load_at(it, g, m); // using product-based index it
+            m.intern_mat(d, tbl); // before Rays share the Zones
+            if (op) m.provide_spectra(*op, tbl);
             Progress det_counter("Detector", level+1, ndet,
                                  diag_counter.get_next_freq(freq_det),
                                  DETSEP, std::cout);
@@ -363,6 +519,8 @@ void Diagnostics::analyze(const Database &d, Hydro &h, Goal &gol)
 
     size_t it = gol.get_best_case();
     h.load_at(it, g, m);
+    m.intern_mat(d, tbl);
+    if (op) m.provide_spectra(*op, tbl);
     double t = h.time_at(0);
     double dt = h.dt_at(0);
     ntd = h.get_ntd();
@@ -7,7 +7,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 5 February 2015\n
- * Last modified on 28 January 2020
+ * Last modified on 17 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -17,7 +17,11 @@
 #include <Database.h>
 #include <Detector.h>
 #include <Goal.h>
+#include <OpacityProvider.h>
 
+#include <functional>
+#include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -43,6 +47,11 @@ public:
     /// List of Detectors
     std::vector<Detector> det;
 
+    /// Flags whether postprocess() reads the next time step, and warms the
+    /// Database spectral cache for it, in a background thread (not done for
+    /// a packed Database, which has no spectral cache to warm)
+    bool prefetch;
+
 //-----------------------------------------------------------------------------
 
     /// Default constructor
@@ -111,6 +120,77 @@ public:
      * @param[in] gol Reference to Goal object
      */
     void execute(const Database &d, Hydro &h, Goal &gol);
+
+    /**
+     * @brief Collects the materials and the Database index ranges that
+     *        postprocess() will use: the union of the Detector hv ranges,
+     *        and the te, tr, ne points of all Zones at all time steps
+     * @param[in] d Reference to Database object
+     * @param[in] h Reference to Hydro object
+     * @return Materials and index ranges (see Database::write_subset)
+     */
+    DbSubset subset(const Database &d, const Hydro &h) const;
+
+    /**
+     * @brief Collects the spectral lookups that postprocess() will make:
+     *        (material, te, tr, ne) of all Zones at all time steps
+     * @param[in] d Reference to Database object
+     * @param[in] h Reference to Hydro object
+     * @return Distinct lookups (see Database::check)
+     */
+    std::set<SpecKey> lookups(const Database &d, const Hydro &h) const;
+
+
+private:
+
+    /**
+     * @brief Loads one time step and reads the spectra that its Zones will
+     *        need into the Database cache (run in a background thread)
+     * @param[in] d Reference to Database object
+     * @param[in] h Reference to Hydro object
+     * @param[in] tbl Table of materials
+     * @param[in] it Time index to be loaded
+     * @param[in] jmin Lower index of the photon energy grid
+     * @param[in] jmax Upper index of the photon energy grid
+     * @param[out] g Grid at time index it
+     * @param[out] m Mesh at time index it
+     */
+    void prefetch_step(const Database &d, const Hydro &h, const Table &tbl,
+                       const size_t it, const size_t jmin, const size_t jmax,
+                       Grid &g, Mesh &m) const;
+
+    /**
+     * @brief Visits the Database lookups of all Zones at all time steps,
+     *        as made by postprocess()
+     * @param[in] d Reference to Database object
+     * @param[in] h Reference to Hydro object
+     * @param[in] f Called with material file handle, ite, itr, ine
+     */
+    void walk_lookups(const Database &d, const Hydro &h,
+        const std::function<void(const std::string &, size_t, size_t, size_t)>
+            &f) const;
+
+    /**
+     * @brief Union of the photon energy ranges of all monochromatic
+     *        Detectors (band-averaged Detectors use Database::get_bands)
+     * @param[in] d Reference to Database object
+     * @param[out] jmin Lower index of the photon energy grid
+     * @param[out] jmax Upper index of the photon energy grid
+     *             (jmin > jmax, if there are no such Detectors)
+     */
+    void hv_range(const Database &d, size_t &jmin, size_t &jmax) const;
+
+    /**
+     * @brief Starts the external opacity server named by TOPS_command
+     * @param[in] d Reference to Database object
+     * @param[in] jmin Lower index of the photon energy grid
+     * @param[in] jmax Upper index of the photon energy grid
+     * @return PipeProvider; nullptr if TOPS_command is "none" or the photon
+     *         energy range is empty
+     */
+    std::shared_ptr<OpacityProvider> opacity_provider(const Database &d,
+                                                      const size_t jmin,
+                                                      const size_t jmax) const;
 };
 
 //-----------------------------------------------------------------------------
@@ -4,7 +4,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 20 November 2014\n
- * Last modified on 28 January 2020
+ * Last modified on 16 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -41,6 +41,13 @@ Face::~Face()
 
 //-----------------------------------------------------------------------------
 
+void Face::compile(const Grid &g)
+{
+    (void)(g);
+}
+
+//-----------------------------------------------------------------------------
+
 void Face::clear()
 {
     my_zone = 0;
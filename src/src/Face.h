@@ -7,7 +7,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 20 November 2014\n
- * Last modified on 26 February 2020
+ * Last modified on 16 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -320,6 +320,15 @@ public:
                                    const double eqt, const FaceID &fid)
                                    const = 0;
 
+    /**
+     * @brief Precomputes the geometry of *this Face for the given Grid, so
+     *        that intercept() and contains() need not rebuild it per Ray;
+     *        the compiled data are used only while Grid::get_stamp matches
+     *        (no-op by default)
+     * @param[in] g Grid of Node objects
+     */
+    virtual void compile(const Grid &g);
+
     /**
      * @brief Velocity of a point on *this Face
      * @param[in] g Grid of Node objects
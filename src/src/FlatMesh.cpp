@@ -0,0 +1,268 @@
+/**
+ * @file FlatMesh.cpp
+ * @brief Flattened (CSR) copy of the Face geometry of a Mesh for Ray tracing
+ * @author Peter Hakel
+ * @version 0.9
+ * @date Created on 16 October 2026\n
+ * Last modified on 16 October 2026
+ * @copyright (c) 2015, Triad National Security, LLC.
+ * All rights reserved.\n
+ * Use of this source code is governed by the BSD 3-Clause License.
+ * See top-level license.txt file for full license text.
+ */
+
+#include <FlatMesh.h>
+
+#include <Polygon.h>
+#include <Sphere.h>
+#include <utils.h>
+
+#include <cmath>
+
+//-----------------------------------------------------------------------------
+
+FlatMesh::FlatMesh(): stamp(0), zone_off(), kind(), fid(), node_off(),
+    node(), ox(), oy(), oz(), nx(), ny(), nz(), dr(), vx(), vy(), vz(),
+    face() {}
+
+//-----------------------------------------------------------------------------
+
+void FlatMesh::clear()
+{
+    stamp = 0;
+    zone_off.clear();
+    kind.clear();
+    fid.clear();
+    node_off.clear();
+    node.clear();
+    for (auto v : {&ox, &oy, &oz, &nx, &ny, &nz, &dr, &vx, &vy, &vz})
+        v->clear();
+    face.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void FlatMesh::build(const std::vector<ZonePtr> &zone, const Grid &g)
+{
+    clear();
+    zone_off.reserve(zone.size() + 1);
+    for (auto &z : zone)
+    {
+        zone_off.push_back(kind.size());
+        for (size_t i = 0; i < z->size(); ++i)
+        {
+            FacePtr f = z->get_face(static_cast<short int>(i));
+            auto s = std::dynamic_pointer_cast<Sphere>(f);
+            const bool is_polygon = (std::dynamic_pointer_cast<Polygon>(f)
+                                     != nullptr);
+            const size_t nn = (is_polygon || s) ? f->size() : 0;
+            fid.push_back(FaceID(f->get_my_zone(), f->get_my_id()));
+            node_off.push_back(node.size());
+            for (size_t j = 0; j < nn; ++j) node.push_back(f->get_node(j));
+
+            Vector3d o, n;
+            double d = 0.0;
+            if (is_polygon)
+            {   // same steps as Polygon::compile
+                kind.push_back(POLYGON);
+                face.push_back(nullptr);
+                n = f->normal(g);
+                o = g.getr(f->get_node(0));
+                d = n * o;
+            }
+            else if (s)
+            {
+                kind.push_back(SPHERE);
+                face.push_back(nullptr);
+                o = g.getr(f->get_node(0));
+                d = s->getr();
+            }
+            else
+            {
+                kind.push_back(OTHER);
+                face.push_back(f);
+            }
+
+            ox.push_back(o.getx());
+            oy.push_back(o.gety());
+            oz.push_back(o.getz());
+            nx.push_back(n.getx());
+            ny.push_back(n.gety());
+            nz.push_back(n.getz());
+            dr.push_back(d);
+            for (size_t j = 0; j < nn; ++j)
+            {
+                const Vector3d w = g.getr(f->get_node(j));
+                vx.push_back(w.getx());
+                vy.push_back(w.gety());
+                vz.push_back(w.getz());
+            }
+        }
+    }
+    zone_off.push_back(kind.size());
+    node_off.push_back(node.size());
+    stamp = g.get_stamp();
+}
+
+//-----------------------------------------------------------------------------
+
+bool FlatMesh::is_current(const Grid &g) const
+{
+    return stamp != 0  &&  stamp == g.get_stamp();
+}
+
+//-----------------------------------------------------------------------------
+
+size_t FlatMesh::size() const
+{
+    return zone_off.empty() ? 0 : zone_off.size() - 1;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t FlatMesh::get_nfaces() const
+{
+    return kind.size();
+}
+
+//-----------------------------------------------------------------------------
+
+FlatMesh::Kind FlatMesh::get_kind(const size_t iz, const size_t i) const
+{
+    return kind.at(zone_off.at(iz) + i);
+}
+
+//-----------------------------------------------------------------------------
+
+RetIntercept FlatMesh::hit(const Grid &g, const size_t iz, const Vector3d &p,
+                           const Vector3d &u, const FaceID &f) const
+{
+    const double EQT = 1.0e-19; // see Zone::hit
+    RetIntercept rv, pt;
+    const size_t kb = zone_off[iz];
+    const size_t ke = zone_off[iz+1];
+
+    rv.t = Vector3d::get_big();
+    for (size_t k = kb; k < ke; ++k) // loop over the Zone's Faces
+    {
+        switch (kind[k])
+        {
+            case POLYGON: pt = polygon(k, p, u, EQT, f); break;
+            case SPHERE:  pt = sphere(k, p, u, EQT, f);  break;
+            default:      pt = face[k]->intercept(g, p, u, EQT, f);
+        }
+        if (pt.is_found  &&  pt.t < rv.t) rv = pt;
+    }
+
+    return rv;
+}
+
+//-----------------------------------------------------------------------------
+
+RetIntercept FlatMesh::polygon(const size_t k, const Vector3d &p,
+                               const Vector3d &u, const double eqt,
+                               const FaceID &f) const
+{
+    RetIntercept rv;
+    rv.fid = fid[k];
+    const double ux = u.getx(), uy = u.gety(), uz = u.getz();
+    const double denominator = ux * nx[k]  +  uy * ny[k]  +  uz * nz[k];
+
+    if (rv.fid == f  ||  fabs(denominator) < Vector3d::get_small())
+    {
+        const double BIG = -Vector3d::get_big();
+        rv.t = BIG;
+        rv.w = Vector3d(BIG, BIG, BIG);
+        rv.is_found = false;
+    }
+    else
+    {
+        const double px = p.getx(), py = p.gety(), pz = p.getz();
+        const double numerator =
+            dr[k] - (px * nx[k]  +  py * ny[k]  +  pz * nz[k]);
+        rv.t = numerator / denominator;
+        rv.w = Vector3d(px + ux * rv.t, py + uy * rv.t, pz + uz * rv.t);
+        rv.is_found = utils::sign_eqt(rv.t, eqt) == 1  &&
+                      polygon_crosses(k, p, u);
+    }
+
+    return rv;
+}
+
+//-----------------------------------------------------------------------------
+
+bool FlatMesh::polygon_crosses(const size_t k, const Vector3d &p,
+                               const Vector3d &u) const
+{   // same arithmetic as Polygon::crosses
+    int first_turn = 0;
+    const double px = p.getx(), py = p.gety(), pz = p.getz();
+    const double ux = u.getx(), uy = u.gety(), uz = u.getz();
+    const size_t jb = node_off[k];
+    const size_t je = node_off[k+1];
+    double ax = vx[je-1] - px, ay = vy[je-1] - py, az = vz[je-1] - pz;
+    for (size_t j = jb; j < je; ++j) // loop over the sides
+    {
+        const double bx = vx[j] - px, by = vy[j] - py, bz = vz[j] - pz;
+        const double s = ux * (ay * bz - az * by)
+                       + uy * (az * bx - ax * bz)
+                       + uz * (ax * by - ay * bx);
+        const int turn = (s > 0.0) - (s < 0.0);
+        if (turn != 0)
+        {
+            if (first_turn == 0)
+                first_turn = turn;
+            else if (first_turn != turn)
+                return false;
+        }
+        ax = bx;
+        ay = by;
+        az = bz;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+RetIntercept FlatMesh::sphere(const size_t k, const Vector3d &p,
+                              const Vector3d &u, const double eqt,
+                              const FaceID &f) const
+{
+    RetIntercept rv;
+    rv.fid = fid[k];
+    const double ux = u.getx(), uy = u.gety(), uz = u.getz();
+    const double dx = p.getx() - ox[k];
+    const double dy = p.gety() - oy[k];
+    const double dz = p.getz() - oz[k];
+    const double r = dr[k];
+    const double a = ux * ux  +  uy * uy  +  uz * uz;
+    const double b = 2.0 * (dx * ux  +  dy * uy  +  dz * uz);
+    const double c = (dx * dx  +  dy * dy  +  dz * dz)  -  r * r;
+
+    // as choose_root.inc, with Sphere::contains always true
+    const utils::RetQuad x = utils::solve_quadratic(a, b, c, eqt);
+    if (x.nroots == 0) // Ray does not intersect Face
+    {
+        const double BIG = -Vector3d::get_big();
+        rv.t = BIG;
+        rv.w = Vector3d(BIG, BIG, BIG);
+        rv.is_found = false;
+        return rv;
+    }
+    rv.is_found = utils::sign_eqt(x.x1, eqt) == 1;
+    rv.t = x.x1;
+    if (rv.fid != f  &&  rv.is_found  &&  utils::sign_eqt(x.x2, eqt) == 1)
+        rv.t = x.x2; // 0 < x.x2 <= x.x1
+    rv.w = p  +  u * rv.t;
+    if (fabs(x.x1 - x.x2) < eqt)
+    {   // Ray touches but does not intersect the Sphere
+        const double BIG = -Vector3d::get_big();
+        rv.t = BIG;
+        rv.w = Vector3d(BIG, BIG, BIG);
+        rv.is_found = false;
+    }
+    return rv;
+}
+
+//-----------------------------------------------------------------------------
+
+//  end FlatMesh.cpp
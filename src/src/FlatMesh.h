@@ -0,0 +1,178 @@
+#ifndef LANL_ASC_PEM_FLATMESH_H_
+#define LANL_ASC_PEM_FLATMESH_H_
+
+/**
+ * @file FlatMesh.h
+ * @brief Flattened (CSR) copy of the Face geometry of a Mesh for Ray tracing
+ * @author Peter Hakel
+ * @version 0.9
+ * @date Created on 16 October 2026\n
+ * Last modified on 16 October 2026
+ * @copyright (c) 2015, Triad National Security, LLC.
+ * All rights reserved.\n
+ * Use of this source code is governed by the BSD 3-Clause License.
+ * See top-level license.txt file for full license text.
+ */
+
+#include <Face.h>
+#include <Grid.h>
+#include <Vector3d.h>
+#include <Zone.h>
+
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+/** @brief Flattened (CSR) copy of the Face geometry of a Mesh
+ *
+ * Zones index their Faces through FlatMesh::zone_off, Faces index their
+ * Node IDs through FlatMesh::node_off; per-Face and per-Node data are kept
+ * in separate arrays (structure of arrays). Polygon and Sphere intercepts
+ * are evaluated here, selected by the Face kind, with the same arithmetic
+ * as Polygon::intercept (compiled) and Sphere::intercept; other Faces
+ * (Cone, Surface) keep their virtual Face::intercept. The Zone and Face
+ * objects remain the Mesh's data for input, output, and tests.
+ */
+class FlatMesh
+{
+public:
+
+    /// Face kinds (FlatMesh::kind)
+    enum Kind : unsigned char
+    {
+        POLYGON, ///< Polygon, intercepted by FlatMesh
+        SPHERE,  ///< Sphere, intercepted by FlatMesh
+        OTHER    ///< any other Face, intercepted by Face::intercept
+    };
+
+    /// Default constructor
+    FlatMesh();
+
+    /// Removes all data from *this FlatMesh
+    void clear();
+
+    /**
+     * @brief Flattens the Faces of the given Zones for Grid g
+     * @param[in] zone Zones of a Mesh, in the order of their IDs
+     * @param[in] g Grid of Node objects
+     */
+    void build(const std::vector<ZonePtr> &zone, const Grid &g);
+
+    /**
+     * @brief Flags whether *this FlatMesh was built for g in its current
+     *        state (Grid::get_stamp)
+     * @param[in] g Grid of Node objects
+     * @return true, if build() was called since g last changed
+     */
+    bool is_current(const Grid &g) const;
+
+    /**
+     * @brief Getter for the number of Zones
+     * @return Number of Zones in *this FlatMesh
+     */
+    size_t size() const;
+
+    /**
+     * @brief Getter for the number of Faces
+     * @return Number of Faces of all Zones in *this FlatMesh
+     */
+    size_t get_nfaces() const;
+
+    /**
+     * @brief Getter for the kind of a Face
+     * @param[in] iz Zone index
+     * @param[in] i Face index within its Zone
+     * @return Face kind
+     */
+    Kind get_kind(const size_t iz, const size_t i) const;
+
+    /**
+     * @brief Calculates the hit-point where a Ray enters a Zone, as the
+     *        first pass of Zone::hit (from p only)
+     * @param[in] g Grid of Node objects (as given to build())
+     * @param[in] iz Zone index
+     * @param[in] p Ray exit point (Ray paths are traced backwards)
+     * @param[in] u Reverse of Ray velocity's Vector3d through the Zone
+     * @param[in] f FaceID of the Face through which Ray exits the Zone
+     * @return RetIntercept structure with the info on the next intercept;
+     *         if not found, Zone::hit should retry from its zone_point
+     */
+    RetIntercept hit(const Grid &g, const size_t iz, const Vector3d &p,
+                     const Vector3d &u, const FaceID &f) const;
+
+
+private:
+
+    /// Grid::get_stamp at the last build() (0: not built)
+    size_t stamp;
+
+    /// Per Zone, the range [zone_off[iz], zone_off[iz+1]) of its Faces
+    std::vector<size_t> zone_off;
+
+    /// Face kinds
+    std::vector<Kind> kind;
+
+    /// FaceIDs, as returned in RetIntercept::fid
+    std::vector<FaceID> fid;
+
+    /// Per Face, the range [node_off[k], node_off[k+1]) of its Nodes
+    std::vector<size_t> node_off;
+
+    /// Node IDs of all Faces
+    std::vector<size_t> node;
+
+    /// Polygon: first Node; Sphere: center
+    std::vector<double> ox, oy, oz;
+
+    /// Polygon: unit normal
+    std::vector<double> nx, ny, nz;
+
+    /// Polygon: plane constant (n * origin); Sphere: signed radius
+    std::vector<double> dr;
+
+    /// Per Node of a Polygon: position
+    std::vector<double> vx, vy, vz;
+
+    /// Face pointers for FlatMesh::OTHER kinds (nullptr otherwise)
+    std::vector<FacePtr> face;
+
+    /**
+     * @brief Ray intercept with a Polygon (as Polygon::intercept, compiled)
+     * @param[in] k Face index in *this FlatMesh
+     * @param[in] p Ray starting point
+     * @param[in] u Ray velocity
+     * @param[in] eqt Tolerance parameter for comparisons with zero
+     * @param[in] f FaceID of the Face where p is located
+     * @return RetIntercept struct with next intercept's info
+     */
+    RetIntercept polygon(const size_t k, const Vector3d &p,
+                         const Vector3d &u, const double eqt,
+                         const FaceID &f) const;
+
+    /**
+     * @brief Flags whether a Ray crosses a Polygon (as Polygon::crosses)
+     * @param[in] k Face index in *this FlatMesh
+     * @param[in] p Ray starting point
+     * @param[in] u Ray velocity
+     * @return "true" or "false"
+     */
+    bool polygon_crosses(const size_t k, const Vector3d &p,
+                         const Vector3d &u) const;
+
+    /**
+     * @brief Ray intercept with a Sphere (as Sphere::intercept)
+     * @param[in] k Face index in *this FlatMesh
+     * @param[in] p Ray starting point
+     * @param[in] u Ray velocity
+     * @param[in] eqt Tolerance parameter for comparisons with zero
+     * @param[in] f FaceID of the Face where p is located
+     * @return RetIntercept struct with next intercept's info
+     */
+    RetIntercept sphere(const size_t k, const Vector3d &p,
+                        const Vector3d &u, const double eqt,
+                        const FaceID &f) const;
+};
+
+//-----------------------------------------------------------------------------
+
+#endif  // LANL_ASC_PEM_FLATMESH_H_
@@ -4,7 +4,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 21 November 2014\n
- * Last modified on 28 January 2020
+ * Last modified on 16 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -15,14 +15,23 @@
 
 #include <utils.h>
 
+#include <atomic>
+#include <stdexcept>
+
 //-----------------------------------------------------------------------------
 
-Grid::Grid(): node(), num_nodes(0) {}
+/// Source of Grid::stamp values (0 is never assigned)
+static std::atomic<size_t> last_stamp(0);
+
+//-----------------------------------------------------------------------------
+
+Grid::Grid(): id(), rx(), ry(), rz(), vx(), vy(), vz(), num_nodes(0),
+    stamp(++last_stamp) {}
 
 //-----------------------------------------------------------------------------
 
 Grid::Grid(const std::string &path, const std::string &tlabel):
-    node(), num_nodes(0)
+    id(), rx(), ry(), rz(), vx(), vy(), vz(), num_nodes(0), stamp(0)
 {
     load(path, tlabel);
 }
@@ -32,37 +41,61 @@ Grid::Grid(const std::string &path, const std::string &tlabel):
 void Grid::clear()
 {
     num_nodes = 0;
-    node.clear();
+    id.clear();
+    for (auto c : {&rx, &ry, &rz, &vx, &vy, &vz}) c->clear();
+    restamp();
 }
 
 //-----------------------------------------------------------------------------
 
 void Grid::add_node(const Node &nin)
 {
-    node.emplace_back(nin);
+    id.push_back(0);
+    for (auto c : {&rx, &ry, &rz, &vx, &vy, &vz}) c->push_back(0.0);
+    set_node(num_nodes, nin);
     ++num_nodes;
+    restamp();
 }
 
 //-----------------------------------------------------------------------------
 
 void Grid::add_node(Node &&nin)
 {
-    node.emplace_back(nin);
-    ++num_nodes;
+    add_node(static_cast<const Node &>(nin));
 }
 
 //-----------------------------------------------------------------------------
 
 Node Grid::get_node(const size_t i) const
 {
-    return node.at(i);
+    return Node(id.at(i), getr(i), getv(i));
 }
 
 //-----------------------------------------------------------------------------
 
 void Grid::replace_node(const Node &nin)
 {
-    node.at(nin.geti()) = nin;
+    const size_t i = nin.geti();
+    if (i >= num_nodes)
+        throw std::out_of_range("Node index out of range in "
+                                "Grid::replace_node");
+    set_node(i, nin);
+    restamp();
+}
+
+//-----------------------------------------------------------------------------
+
+void Grid::set_node(const size_t i, const Node &nin)
+{
+    const Vector3d r = nin.getr();
+    const Vector3d v = nin.getv();
+    id[i] = nin.geti();
+    rx[i] = r.getx();
+    ry[i] = r.gety();
+    rz[i] = r.getz();
+    vx[i] = v.getx();
+    vy[i] = v.gety();
+    vz[i] = v.getz();
 }
 
 //-----------------------------------------------------------------------------
@@ -83,7 +116,7 @@ double Grid::abs_diff(const Grid &o) const
     size_t i;
     for (i = 0; i < range; ++i)
     {
-        d = node.at(i).abs_diff(o.node.at(i));
+        d = get_node(i).abs_diff(o.get_node(i));
         diff += d;
     }
     return diff + rdiff*rdiff;
@@ -91,6 +124,20 @@ double Grid::abs_diff(const Grid &o) const
 
 //-----------------------------------------------------------------------------
 
+size_t Grid::get_stamp() const
+{
+    return stamp;
+}
+
+//-----------------------------------------------------------------------------
+
+void Grid::restamp()
+{
+    stamp = ++last_stamp;
+}
+
+//-----------------------------------------------------------------------------
+
 void Grid::load(const std::string &path, const std::string &tlabel)
 {
     clear();
@@ -104,16 +151,17 @@ void Grid::load(const std::string &path, const std::string &tlabel)
     }
     utils::find_line(infile, "# start");
     infile >> num_nodes;
-    node.reserve(num_nodes);
+    id.resize(num_nodes);
+    for (auto c : {&rx, &ry, &rz, &vx, &vy, &vz}) c->resize(num_nodes);
     size_t i, j;
-    double rx, ry, rz, vx, vy, vz;
     for (i = 0; i < num_nodes; ++i)
     {
-        infile >> j >> rx >> ry >> rz >> vx >> vy >> vz;
-        node.emplace_back(Node(i, Vector3d(rx, ry, rz), Vector3d(vx, vy, vz)));
+        infile >> j >> rx[i] >> ry[i] >> rz[i] >> vx[i] >> vy[i] >> vz[i];
+        id[i] = i;
     }
     infile.close();
     infile.clear();
+    restamp();
 }
 
 //-----------------------------------------------------------------------------
@@ -124,7 +172,7 @@ std::string Grid::to_string() const
     for (size_t i = 0; i < num_nodes; ++i)
     {
         if (i > 0) s += "\n";
-        s += node.at(i).to_string();
+        s += get_node(i).to_string();
     }
     return s;
 }
@@ -7,7 +7,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 21 November 2014\n
- * Last modified on 28 January 2020
+ * Last modified on 16 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -22,7 +22,12 @@
 
 //-----------------------------------------------------------------------------
 
-/// Grid of Node objects
+/** @brief Grid of Node objects
+ *
+ * Node data are stored by component (structure of arrays); get_node()
+ * assembles a Node for input, output and tests, whereas the Face code
+ * reads positions and velocities through getr() and getv().
+ */
 class Grid
 {
 public:
@@ -59,6 +64,47 @@ public:
      */
     Node get_node(const size_t i) const;
 
+    /**
+     * @brief Node position, without assembling the Node
+     * @param[in] i Node index (not range-checked)
+     * @return Position of the Node at index i
+     */
+    Vector3d getr(const size_t i) const
+    {
+        return Vector3d(rx[i], ry[i], rz[i]);
+    }
+
+    /**
+     * @brief Node velocity, without assembling the Node
+     * @param[in] i Node index (not range-checked)
+     * @return Velocity of the Node at index i
+     */
+    Vector3d getv(const size_t i) const
+    {
+        return Vector3d(vx[i], vy[i], vz[i]);
+    }
+
+    // Contiguous arrays of Node position and velocity components,
+    // by Node index (e.g., for vectorized loops over all Nodes)
+
+    /// Getter for the x components of Node positions (Grid::rx)
+    const std::vector<double> & get_rx() const {return rx;}
+
+    /// Getter for the y components of Node positions (Grid::ry)
+    const std::vector<double> & get_ry() const {return ry;}
+
+    /// Getter for the z components of Node positions (Grid::rz)
+    const std::vector<double> & get_rz() const {return rz;}
+
+    /// Getter for the x components of Node velocities (Grid::vx)
+    const std::vector<double> & get_vx() const {return vx;}
+
+    /// Getter for the y components of Node velocities (Grid::vy)
+    const std::vector<double> & get_vy() const {return vy;}
+
+    /// Getter for the z components of Node velocities (Grid::vz)
+    const std::vector<double> & get_vz() const {return vz;}
+
     /**
      * @brief Replaces the Node at the location encoded in the new Node
      * @param[in] nin New Node
@@ -78,6 +124,13 @@ public:
      */
     double abs_diff(const Grid &o) const;
 
+    /**
+     * @brief Getter for Grid::stamp
+     * @return Label of the current Node positions; it changes with every
+     *         modification, and is unique among Grids (copies share it)
+     */
+    size_t get_stamp() const;
+
     /**
      * @brief Loads a Grid of Nodes from a file
      * @param[in] path Path to the input file
@@ -94,11 +147,30 @@ public:
 
 private:
 
-    /// Array of Nodes
-    std::vector<Node> node;
+    /// Node IDs (Node::geti), by Node index
+    std::vector<size_t> id;
+
+    /// Components of Node positions, by Node index
+    std::vector<double> rx, ry, rz;
+
+    /// Components of Node velocities, by Node index
+    std::vector<double> vx, vy, vz;
 
     /// Number of Nodes in *this Grid
     size_t num_nodes;
+
+    /// Label of the current Node positions (see get_stamp)
+    size_t stamp;
+
+    /// Assigns a new Grid::stamp, after every modification
+    void restamp();
+
+    /**
+     * @brief Stores a Node at index i of the component arrays
+     * @param[in] i Node index (in range)
+     * @param[in] nin Node
+     */
+    void set_node(const size_t i, const Node &nin);
 };
 
 //-----------------------------------------------------------------------------
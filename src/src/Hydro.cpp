@@ -4,7 +4,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 7 January 2015\n
- * Last modified on 28 January 2020
+ * Last modified on 17 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -52,8 +52,20 @@ Hydro::Hydro(const bool analysis_in, const std::string &hydro_path,
                       << "Hydro::Hydro(parametrized)" << std::endl;
             exit(EXIT_FAILURE);
         }
-        utils::find_word(geometry, "Number_of_zones");
-        geometry >> nzones;
+        std::string word;
+        geometry >> word;
+        if (word == "Block") // structured Block: Zone 0 and one per cell
+        {
+            Block b;
+            b.load(geometry);
+            nzones = 1 + b.size();
+        }
+        else
+        {
+            if (word != "Number_of_zones")
+                utils::find_word(geometry, "Number_of_zones");
+            geometry >> nzones;
+        }
         geometry.close();
         geometry.clear();
         cell.reserve(nzones);
@@ -211,8 +223,14 @@ void Hydro::load_at(const size_t i, Grid &g, Mesh &m) const
     if (analysis) // analysis of case #i
     {
         tlabel = "0";
+        const bool fresh = (g.size() == 0  ||  m.size() == 0);
         if (g.size() == 0) g.load(path, tlabel);
         if (m.size() == 0) m.load(path, tlabel);
+        if (fresh) // geometry is the same for all cases: trace Rays once
+        {
+            m.compile(g);
+            m.set_geo_hash(m.hash_geometry(g));
+        }
         
         if (symmetry == "spherical")
         {
@@ -250,6 +268,8 @@ void Hydro::load_at(const size_t i, Grid &g, Mesh &m) const
         tlabel = utils::int_to_string(i, '0', ntd);
         g.load(path, tlabel);
         m.load(path, tlabel);
+        m.compile(g);
+        m.set_geo_hash(m.hash_geometry(g));
     }
 }
 
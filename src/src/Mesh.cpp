@@ -4,7 +4,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 18 December 2014\n
- * Last modified on 28 January 2020
+ * Last modified on 17 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -13,17 +13,26 @@
 
 #include <Mesh.h>
 
+#include <glob.h>
+#include <Polygon.h>
 #include <Surface.h>
 
 #include <algorithm>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 //-----------------------------------------------------------------------------
 
-Mesh::Mesh(): nzones(0), zone() {}
+Mesh::Mesh(): nzones(0), zone(), linked(false), portal_zone(), portal_off(),
+    portal_fid(), portal_face(), flat(), block(), geo_hash(0) {}
 
 //-----------------------------------------------------------------------------
 
-Mesh::Mesh(const size_t nin): nzones(0), zone()
+Mesh::Mesh(const size_t nin): nzones(0), zone(), linked(false),
+    portal_zone(), portal_off(), portal_fid(), portal_face(), flat(),
+    block(), geo_hash(0)
 {
     zone.reserve(nin);
 }
@@ -31,7 +40,8 @@ Mesh::Mesh(const size_t nin): nzones(0), zone()
 //-----------------------------------------------------------------------------
 
 Mesh::Mesh(const std::string &path, const std::string &tlabel):
-    nzones(0), zone()
+    nzones(0), zone(), linked(false), portal_zone(), portal_off(),
+    portal_fid(), portal_face(), flat(), block(), geo_hash(0)
 {
     load(path, tlabel);
 }
@@ -42,6 +52,14 @@ void Mesh::clear()
 {
     nzones = 0;
     zone.clear();
+    linked = false;
+    portal_zone.clear();
+    portal_off.clear();
+    portal_fid.clear();
+    portal_face.clear();
+    flat.clear();
+    block.clear();
+    geo_hash = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -50,6 +68,9 @@ void Mesh::add_zone(ZonePtr z)
 {
     zone.emplace_back(std::move(z));
     ++nzones;
+    linked = false;
+    flat.clear();
+    geo_hash = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -61,6 +82,132 @@ ZonePtr Mesh::get_zone(const size_t i) const
 
 //-----------------------------------------------------------------------------
 
+Zone & Mesh::zone_at(const size_t i) const
+{
+    return *zone[i];
+}
+
+//-----------------------------------------------------------------------------
+
+void Mesh::compile(const Grid &g)
+{
+    for (auto &z : zone)
+        for (size_t i = 0; i < z->size(); ++i)
+            z->get_face(static_cast<short int>(i))->compile(g);
+    flat.build(zone, g);
+}
+
+//-----------------------------------------------------------------------------
+
+RetIntercept Mesh::hit(const Grid &g, const size_t iz, const Vector3d &p,
+                       const Vector3d &u, const FaceID &fid) const
+{
+    if (flat.is_current(g))
+    {
+        RetIntercept rv = flat.hit(g, iz, p, u, fid);
+        if (rv.is_found) return rv;
+    }
+    return zone[iz]->hit(g, p, u, fid); // incl. retry from Zone::zone_point
+}
+
+//-----------------------------------------------------------------------------
+
+const FlatMesh & Mesh::get_flat() const
+{
+    return flat;
+}
+
+//-----------------------------------------------------------------------------
+
+const Block & Mesh::get_block() const
+{
+    return block;
+}
+
+//-----------------------------------------------------------------------------
+
+void Mesh::set_geo_hash(const uint64_t h)
+{
+    geo_hash = h;
+}
+
+//-----------------------------------------------------------------------------
+
+uint64_t Mesh::get_geo_hash() const
+{
+    return geo_hash;
+}
+
+//-----------------------------------------------------------------------------
+
+uint64_t Mesh::hash_geometry(const Grid &g) const
+{   // equal nonzero hashes flag the same Ray paths (see Detector)
+    uint64_t h = utils::hash_string(block.to_string());
+    for (auto v : {&g.get_rx(), &g.get_ry(), &g.get_rz(),
+                   &g.get_vx(), &g.get_vy(), &g.get_vz()})
+        h = utils::hash_bytes(v->data(), v->size() * sizeof(double), h);
+    for (auto &z : zone)
+        for (size_t i = 0; i < z->size(); ++i)
+        {
+            FacePtr f = z->get_face(static_cast<short int>(i));
+            if (std::dynamic_pointer_cast<Polygon>(f) == nullptr)
+            {   // curved Faces carry parameters of their own
+                h = utils::hash_string(f->to_string(), h);
+                continue;
+            }
+            const size_t nn = f->size();
+            h = utils::hash_bytes(&nn, sizeof(nn), h);
+            for (size_t j = 0; j < nn; ++j)
+            {
+                const size_t k = f->get_node(j);
+                h = utils::hash_bytes(&k, sizeof(k), h);
+            }
+            for (size_t j = 0; j < f->num_nbr(); ++j)
+            {
+                const FaceID n = f->get_neighbor(j);
+                h = utils::hash_bytes(&n.my_zone, sizeof(n.my_zone), h);
+                h = utils::hash_bytes(&n.my_id, sizeof(n.my_id), h);
+            }
+        }
+    return h == 0 ? 1 : h;
+}
+
+//-----------------------------------------------------------------------------
+
+void Mesh::intern_mat(const Database &d, const Table &tbl) const
+{
+    for (auto &z : zone) z->intern_mat(d, tbl);
+}
+
+//-----------------------------------------------------------------------------
+
+void Mesh::provide_spectra(OpacityProvider &op, const Table &tbl) const
+{
+    std::vector<OpacityRequest> rq;
+    rq.reserve(zone.size());
+    for (auto &z : zone) rq.emplace_back(z->opacity_request(tbl));
+    op.request(rq);
+    for (size_t i = 0; i < zone.size(); ++i)
+        zone.at(i)->set_spectra(op.reply(rq.at(i)),
+                                op.get_jmin(), op.get_jmax());
+}
+
+//-----------------------------------------------------------------------------
+
+void Mesh::mix_spectra(const Database &d, const Table &tbl,
+                       const size_t jmin, const size_t jmax) const
+{
+    const size_t n = zone.size();
+    #ifdef _OPENMP
+    omp_set_num_threads(glob::nthreads);
+    #pragma omp parallel for schedule(dynamic)
+    #endif
+    for (size_t i = 0; i < n; ++i)
+        zone[i]->mix_spectra(d, tbl, jmin, jmax);
+}
+
+//-----------------------------------------------------------------------------
+
 size_t Mesh::size() const
 {
     return nzones;
@@ -68,35 +215,94 @@ size_t Mesh::size() const
 
 //-----------------------------------------------------------------------------
 
+void Mesh::link()
+{
+    portal_zone.assign(zone.size() + 1, 0);
+    portal_off.clear();
+    portal_fid.clear();
+    portal_face.clear();
+    SurfacePtr fs; // bounding Sphere Zone's inner Surface, cast once
+    for (size_t iz = 0; iz < zone.size(); ++iz)
+    {
+        auto z = zone.at(iz);
+        portal_zone.at(iz) = portal_off.size();
+        for (size_t i = 0; i < z->size(); ++i)
+        {
+            auto f = z->get_face(static_cast<short int>(i));
+            portal_off.push_back(portal_fid.size());
+            for (size_t j = 0; j < f->num_nbr(); ++j)
+            {
+                FaceID fid = f->get_neighbor(j);
+                if (fid.my_id == -1) // the neighbor is the bounding Sphere Zone
+                {
+                    if (!fs)
+                        fs = std::dynamic_pointer_cast<Surface>(
+                            zone.at(0)->get_face(1));
+                    portal_fid.push_back(FaceID(0, 1));
+                    portal_face.push_back(fs->get_face(fid.my_zone));
+                }
+                else // the neighbor is a regular Zone
+                {
+                    portal_fid.push_back(fid);
+                    portal_face.push_back(
+                        zone.at(fid.my_zone)->get_face(fid.my_id));
+                }
+            }
+        }
+    }
+    portal_zone.at(zone.size()) = portal_off.size();
+    portal_off.push_back(portal_fid.size());
+    linked = true;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t Mesh::get_nportals() const
+{
+    if (!linked) return 0;
+    size_t n = 0;
+    for (size_t k = 0; k + 1 < portal_off.size(); ++k)
+        if (portal_off[k+1] - portal_off[k] == 1) ++n;
+    return n;
+}
+
+//-----------------------------------------------------------------------------
+
 FaceID Mesh::next_face(const Grid &g, const RetIntercept &h) const
 {
     if (h.fid.my_id == -1) // exit Face is the Surface of bounding Sphere Zone
     {
-        auto z = get_zone(0);    // bounding Sphere Zone
-        auto f = z->get_face(1); // inner Surface of *z
-        return f->get_neighbor(h.fid.my_zone); // 1-to-1 pairing of Faces here
+        const Face &f = zone_at(0).face_at(1); // inner Surface of bounding
+        return f.get_neighbor(h.fid.my_zone); // 1-to-1 pairing of Faces here
+    }
+    else if (linked) // portal table
+    {
+        const size_t k = portal_zone[h.fid.my_zone] + h.fid.my_id;
+        const size_t kb = portal_off[k];
+        const size_t ke = portal_off[k+1];
+        if (ke - kb == 1) return portal_fid[kb]; // one-to-one portal
+        for (size_t i = kb; i < ke; ++i)
+            if (portal_face[i]->contains(g, h.w)) return portal_fid[i];
+        return FaceID(); // bounding Sphere's outer Face has no neighbors
     }
     else // regular Zone
     {    // or exiting bounding Sphere Zone through its outer Face (Sphere)
-        auto z = get_zone(h.fid.my_zone);  // this Zone
-        auto f = z->get_face(h.fid.my_id); // exit Face of *z
-        size_t nf = f->num_nbr();
+        const Face &f = zone_at(h.fid.my_zone).face_at(h.fid.my_id); // exit
+        size_t nf = f.num_nbr();
         for (size_t i = 0; i < nf; ++i)
         {
-            FaceID fid = f->get_neighbor(i);
+            FaceID fid = f.get_neighbor(i);
             if (fid.my_id == -1) // the neighbor is the bounding Sphere Zone
             {
-                auto nz = get_zone(0);
-                FacePtr fz = nz->get_face(1);
-                SurfacePtr fs = std::dynamic_pointer_cast<Surface>(fz);
-                auto fn = fs->get_face(fid.my_zone);
-                if (fn->contains(g, h.w)) return FaceID(0, 1);
+                const Surface &fs =
+                    dynamic_cast<const Surface &>(zone_at(0).face_at(1));
+                if (fs.face_at(fid.my_zone).contains(g, h.w))
+                    return FaceID(0, 1);
             }
             else // the neighbor is a regular Zone
             {
-                auto nz = get_zone(fid.my_zone);
-                auto fn = nz->get_face(fid.my_id);
-                if (fn->contains(g, h.w)) return fid;
+                const Face &fn = zone_at(fid.my_zone).face_at(fid.my_id);
+                if (fn.contains(g, h.w)) return fid;
             }
         }
         return FaceID(); // bounding Sphere's outer Face has no neighbors
@@ -116,9 +322,18 @@ void Mesh::load(const std::string &path, const std::string &tlabel)
                   << "Mesh::load" << std::endl;
         exit(EXIT_FAILURE);
     }
-    utils::find_word(geometry, "Number_of_zones");
-    geometry >> nzones;
-    zone.reserve(nzones);
+    std::string word;
+    geometry >> word;
+    const bool is_block = (word == "Block");
+    if (is_block)
+        block.load(geometry);
+    else
+    {
+        if (word != "Number_of_zones")
+            utils::find_word(geometry, "Number_of_zones");
+        geometry >> nzones;
+        zone.reserve(nzones);
+    }
 
     fname = path + "time_" + tlabel + ".txt";
     std::ifstream material(fname.c_str());
@@ -129,17 +344,34 @@ void Mesh::load(const std::string &path, const std::string &tlabel)
         exit(EXIT_FAILURE);
     }
 
-    for (size_t i = 0; i < nzones; ++i)
-    {
+    if (is_block)
+    {   // bounding Sphere Zone from file, then one Zone per cell
+        nzones = 1 + block.size();
+        zone.reserve(nzones);
         utils::find_word(geometry, "Zone");
         utils::find_word(material, "Zone");
         zone.emplace_back(std::make_shared<Zone>(geometry, material));
+        for (size_t i = 1; i < nzones; ++i)
+        {
+            auto z = std::make_shared<Zone>(i);
+            utils::find_word(material, "Zone");
+            z->load_mat(material);
+            zone.emplace_back(std::move(z));
+        }
     }
+    else
+        for (size_t i = 0; i < nzones; ++i)
+        {
+            utils::find_word(geometry, "Zone");
+            utils::find_word(material, "Zone");
+            zone.emplace_back(std::make_shared<Zone>(geometry, material));
+        }
 
     geometry.close();
     geometry.clear();
     material.close();
     material.clear();
+    link();
 }
 
 //-----------------------------------------------------------------------------
@@ -7,15 +7,18 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 18 December 2014\n
- * Last modified on 28 January 2020
+ * Last modified on 17 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
  * See top-level license.txt file for full license text.
  */
 
+#include <Block.h>
+#include <FlatMesh.h>
 #include <Zone.h>
 
+#include <cstdint>
 #include <memory>
 
 //-----------------------------------------------------------------------------
@@ -57,14 +60,39 @@ public:
      */
     ZonePtr get_zone(const size_t i) const;
 
+    /**
+     * @brief Non-owning access to the Zone at index i (Mesh::zone), for
+     *        Ray traversal: unlike get_zone(), no reference count is touched
+     * @param[in] i Zone index (not range-checked)
+     * @return Reference to the Zone at index i
+     */
+    Zone & zone_at(const size_t i) const;
+
     /**
      * @brief Getter for the size of *this Mesh (Mesh::nzones)
      * @return Number of Zones in *this Mesh
      */
     size_t size() const;
 
+    /**
+     * @brief Builds the portal table of *this Mesh from the Face neighbor
+     *        lists (called by load(); call again after add_zone()): a Face
+     *        with a single neighbor is a one-to-one portal, other Faces keep
+     *        their candidate neighbor Faces resolved, so that next_face()
+     *        needs no pointer casts
+     */
+    void link();
+
+    /**
+     * @brief Getter for the number of one-to-one portals
+     * @return Number of Faces with a single neighbor (0, if link() has not
+     *         been called since the last change of *this Mesh)
+     */
+    size_t get_nportals() const;
+
     /**
      * @brief Finds which of neighboring Faces contains hit point h
+     *        (directly for a one-to-one portal; see link())
      * @param[in] g Grid
      * @param[in] h Hit point at which Ray exits current Zone
      * @return IDs of the next Zone and Face encountered by the current Ray
@@ -72,7 +100,91 @@ public:
     FaceID next_face(const Grid &g, const RetIntercept &h) const;
 
     /**
-     * @brief Constructor helper: loads Mesh from files
+     * @brief Precomputes the geometry of all Faces for Grid g
+     *        (Face::compile) and flattens it (Mesh::flat); call after both
+     *        are loaded for a time step
+     * @param[in] g Grid
+     */
+    void compile(const Grid &g);
+
+    /**
+     * @brief Calculates the hit-point where a Ray enters a Zone, as
+     *        Zone::hit, through the flattened geometry when it is current
+     * @param[in] g Grid
+     * @param[in] iz Zone index
+     * @param[in] p Ray exit point (Ray paths are traced backwards)
+     * @param[in] u Reverse of Ray velocity's Vector3d through the Zone
+     * @param[in] fid FaceID of the Face through which Ray exits the Zone
+     * @return RetIntercept structure with the info on the next intercept
+     */
+    RetIntercept hit(const Grid &g, const size_t iz, const Vector3d &p,
+                     const Vector3d &u, const FaceID &fid) const;
+
+    /**
+     * @brief Getter for the flattened geometry (Mesh::flat)
+     * @return Flattened Faces, as of the last compile()
+     */
+    const FlatMesh & get_flat() const;
+
+    /**
+     * @brief Getter for the structured Cartesian Block (Mesh::block)
+     * @return Block of cells; empty (size() == 0) for Meshes made of Faces
+     */
+    const Block & get_block() const;
+
+    /**
+     * @brief Setter for the geometry hash (Mesh::geo_hash)
+     * @param[in] h Content hash of the Grid and Mesh geometry, e.g., from
+     *            hash_geometry() (0: unknown)
+     */
+    void set_geo_hash(const uint64_t h);
+
+    /**
+     * @brief Getter for the geometry hash (Mesh::geo_hash)
+     * @return Content hash of the Grid and Mesh geometry; equal nonzero
+     *         values mean equal Ray paths (0: unknown)
+     */
+    uint64_t get_geo_hash() const;
+
+    /**
+     * @brief Content hash of the loaded geometry: Node positions and
+     *        velocities, Faces with their Nodes and neighbors, and the Block
+     * @param[in] g Grid of Nodes used by *this Mesh
+     * @return Nonzero hash for set_geo_hash()
+     */
+    uint64_t hash_geometry(const Grid &g) const;
+
+    /**
+     * @brief Resolves the materials of all Zones into Database material
+     *        indices (Zone::intern_mat)
+     * @param[in] d Database
+     * @param[in] tbl Table of materials
+     */
+    void intern_mat(const Database &d, const Table &tbl) const;
+
+    /**
+     * @brief Precomputes mixed optical data of all Zones (Zone::mix_spectra)
+     *        in a parallel loop over Zones
+     * @param[in] d Database
+     * @param[in] tbl Table of materials
+     * @param[in] jmin Lower index of the photon energy grid
+     * @param[in] jmax Upper index of the photon energy grid
+     */
+    void mix_spectra(const Database &d, const Table &tbl,
+                     const size_t jmin, const size_t jmax) const;
+
+    /**
+     * @brief Obtains mixed optical data of all Zones from an OpacityProvider
+     *        (one round trip for all distinct Zone states; Zone::set_spectra)
+     * @param[in,out] op OpacityProvider
+     * @param[in] tbl Table of materials
+     */
+    void provide_spectra(OpacityProvider &op, const Table &tbl) const;
+
+    /**
+     * @brief Constructor helper: loads Mesh from files; a mesh_*.txt file
+     *        starting with the word "Block" holds a structured Cartesian
+     *        Block (see Block), whose cells become Zones 1 through N
      * @param[in] path Directory path to hydro data
      * @param[in] tlabel Time-step index label in string form
      */
@@ -92,6 +204,32 @@ private:
 
     /// Container of Zones
     std::vector<ZonePtr> zone;
+
+    /// Flags whether the portal table (Mesh::portal_*) is current
+    bool linked;
+
+    /// Position of the first Face of each Zone in Mesh::portal_off
+    std::vector<size_t> portal_zone;
+
+    /// Per Face, the range [portal_off[k], portal_off[k+1]) of its
+    /// candidates in Mesh::portal_fid and Mesh::portal_face
+    std::vector<size_t> portal_off;
+
+    /// Candidate next FaceIDs, as returned by next_face()
+    std::vector<FaceID> portal_fid;
+
+    /// Candidate Faces to test for containment of the hit point
+    std::vector<FacePtr> portal_face;
+
+    /// Flattened Face geometry for Ray tracing, built by compile()
+    FlatMesh flat;
+
+    /// Structured Cartesian Block, if *this Mesh is one; otherwise empty
+    Block block;
+
+    /// Content hash of the geometry (see set_geo_hash); reset by clear()
+    /// and add_zone()
+    uint64_t geo_hash;
 };
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,289 @@
+/**
+ * @file OpacityProvider.cpp
+ * @brief Source of mixed Zone optical data outside of the Database
+ *        (e.g., a TOPS-like server), with batched requests and a reply cache
+ * @author Peter Hakel
+ * @version 0.9
+ * @date Created on 16 October 2026\n
+ * Last modified on 16 October 2026
+ * @copyright (c) 2015, Triad National Security, LLC.
+ * All rights reserved.\n
+ * Use of this source code is governed by the BSD 3-Clause License.
+ * See top-level license.txt file for full license text.
+ */
+
+#include <OpacityProvider.h>
+
+#include <ArrDbl.h>
+
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <tuple>
+
+//-----------------------------------------------------------------------------
+
+bool OpacityRequest::operator < (const OpacityRequest &o) const
+{
+    return std::tie(te, tr, np, mat, fp) < std::tie(o.te, o.tr, o.np,
+                                                    o.mat, o.fp);
+}
+
+//-----------------------------------------------------------------------------
+
+OpacityProvider::OpacityProvider(const size_t jmin_in, const size_t jmax_in):
+    jmin(jmin_in), jmax(jmax_in), cache(), ntrips(0), nsent(0), nhits(0)
+{
+    if (jmin > jmax)
+    {
+        std::cerr << "Error: empty photon energy range " << jmin << " "
+                  << jmax << " in OpacityProvider::OpacityProvider"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+OpacityProvider::~OpacityProvider() {}
+
+//-----------------------------------------------------------------------------
+
+size_t OpacityProvider::get_jmin() const
+{
+    return jmin;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t OpacityProvider::get_jmax() const
+{
+    return jmax;
+}
+
+//-----------------------------------------------------------------------------
+
+void OpacityProvider::request(const std::vector<OpacityRequest> &rq)
+{
+    // only the replies of this call are kept, so that the cache does not
+    // grow with every time step of continuous hydro states
+    std::map<OpacityRequest, OpacityReply> kept;
+    std::vector<OpacityRequest> batch;
+    std::map<OpacityRequest, size_t> pending;
+    for (auto &r : rq)
+    {
+        auto it = cache.find(r);
+        if (it != cache.end())
+        {
+            kept[r] = std::move(it->second);
+            cache.erase(it);
+            ++nhits;
+        }
+        else if (kept.count(r) > 0  ||  pending.count(r) > 0)
+            ++nhits;
+        else
+        {
+            pending[r] = batch.size();
+            batch.push_back(r);
+        }
+    }
+    cache.swap(kept);
+    if (batch.empty()) return;
+
+    std::vector<OpacityReply> rp =
+        read_reply(round_trip(write_batch(batch, jmin, jmax)),
+                   batch.size(), jmax - jmin + 1);
+    for (size_t i = 0; i < batch.size(); ++i)
+        cache[batch.at(i)] = std::move(rp.at(i));
+    ++ntrips;
+    nsent += batch.size();
+}
+
+//-----------------------------------------------------------------------------
+
+const OpacityReply & OpacityProvider::reply(const OpacityRequest &r) const
+{
+    auto it = cache.find(r);
+    if (it == cache.end())
+    {
+        std::cerr << "Error: no reply for te = " << r.te << ", tr = " << r.tr
+                  << ", np = " << r.np << " in OpacityProvider::reply"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return it->second;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t OpacityProvider::get_ntrips() const
+{
+    return ntrips;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t OpacityProvider::get_nsent() const
+{
+    return nsent;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t OpacityProvider::get_nhits() const
+{
+    return nhits;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t OpacityProvider::get_cache_size() const
+{
+    return cache.size();
+}
+
+//-----------------------------------------------------------------------------
+
+std::string OpacityProvider::to_string() const
+{
+    return "Opacity provider: " + std::to_string(ntrips) + " round trips, "
+         + std::to_string(nsent) + " requests sent, "
+         + std::to_string(nhits) + " cache hits";
+}
+
+//-----------------------------------------------------------------------------
+
+std::string OpacityProvider::write_batch(const std::vector<OpacityRequest> &rq,
+                                         const size_t jmin, const size_t jmax)
+{
+    std::ostringstream ost;
+    ost << std::setprecision(std::numeric_limits<double>::max_digits10);
+    ost << "batch " << rq.size() << " " << jmin << " " << jmax << "\n";
+    for (auto &r : rq)
+    {
+        ost << r.mat.size();
+        for (size_t i = 0; i < r.mat.size(); ++i)
+            ost << " " << r.mat.at(i) << " " << r.fp.at(i);
+        ost << " " << r.te << " " << r.tr << " " << r.np << "\n";
+    }
+    return ost.str();
+}
+
+//-----------------------------------------------------------------------------
+
+std::vector<OpacityReply> OpacityProvider::read_reply(const std::string &msg,
+                                                      const size_t n,
+                                                      const size_t nhv)
+{
+    std::istringstream ist(msg);
+    std::string word;
+    size_t n_in(0), nhv_in(0);
+    ist >> word >> n_in >> nhv_in;
+    if (!ist  ||  word != "reply"  ||  n_in != n  ||  nhv_in != nhv)
+    {
+        std::cerr << "Error: unexpected reply header (expected " << n << " "
+                  << nhv << ") in OpacityProvider::read_reply" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::vector<OpacityReply> rp(n);
+    for (auto &r : rp)
+    {
+        r.em.resize(nhv);
+        r.ab.resize(nhv);
+        r.sc.resize(nhv);
+        ist >> r.ne;
+        for (auto &x : r.em) ist >> x;
+        for (auto &x : r.ab) ist >> x;
+        for (auto &x : r.sc) ist >> x;
+    }
+    ist >> word;
+    if (!ist  ||  word != "end")
+    {
+        std::cerr << "Error: truncated reply in OpacityProvider::read_reply"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return rp;
+}
+
+//-----------------------------------------------------------------------------
+
+size_t OpacityProvider::serve(const Database &d, std::istream &in,
+                              std::ostream &out)
+{
+    out << std::setprecision(std::numeric_limits<double>::max_digits10);
+    size_t nbatches = 0;
+    std::string word;
+    while (in >> word)
+    {
+        size_t n(0), jmin(0), jmax(0);
+        in >> n >> jmin >> jmax;
+        if (!in  ||  word != "batch"  ||  jmin > jmax  ||  jmax >= d.get_nhv())
+        {
+            std::cerr << "Error: bad batch header in OpacityProvider::serve"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        size_t nhv = jmax - jmin + 1;
+        out << "reply " << n << " " << nhv << "\n";
+        for (size_t k = 0; k < n; ++k)
+        {
+            unsigned short int nmat(0);
+            in >> nmat;
+            std::vector<size_t> mid(nmat);
+            std::vector<double> fp(nmat);
+            for (unsigned short int i = 0; i < nmat; ++i)
+            {
+                in >> word >> fp.at(i);
+                mid.at(i) = d.material_index(word);
+            }
+            double te(0.0), tr(0.0), np(0.0);
+            in >> te >> tr >> np;
+            if (!in)
+            {
+                std::cerr << "Error: bad request " << k << " in "
+                          << "OpacityProvider::serve" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+
+            // same steps and arithmetic as Zone::load_spectra
+            size_t ite(0), itr(0), ine(0);
+            ArrDbl em, ab, sc;
+            em.assign(nhv, 0.0);
+            ab.assign(nhv, 0.0);
+            sc.assign(nhv, 0.0);
+            double ne(0.0);
+            if (nmat > 0)
+            {
+                ArrDbl vem(nhv), vab(nhv), vsc(nhv);
+                ne = d.find_ne(te, ite, tr, itr, np, nmat, mid, fp, ine);
+                for (unsigned short int i = 0; i < nmat; ++i)
+                {
+                    d.get_spectra(mid.at(i), ite, itr, ine,
+                                  jmin, jmax, vem, vab, vsc);
+                    double fpop = fp.at(i);
+                    em  +=  fpop * vem;
+                    ab  +=  fpop * vab;
+                    sc  +=  fpop * vsc;
+                }
+                em *= np;
+                ab *= np;
+                sc *= np;
+            }
+
+            out << ne;
+            for (size_t j = 0; j < nhv; ++j) out << " " << em[j];
+            for (size_t j = 0; j < nhv; ++j) out << " " << ab[j];
+            for (size_t j = 0; j < nhv; ++j) out << " " << sc[j];
+            out << "\n";
+        }
+        out << "end" << std::endl;
+        ++nbatches;
+    }
+    return nbatches;
+}
+
+//-----------------------------------------------------------------------------
+
+//  end OpacityProvider.cpp
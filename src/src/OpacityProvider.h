@@ -0,0 +1,220 @@
+#ifndef LANL_ASC_PEM_OPACITYPROVIDER_H_
+#define LANL_ASC_PEM_OPACITYPROVIDER_H_
+
+/**
+ * @file OpacityProvider.h
+ * @brief Source of mixed Zone optical data outside of the Database
+ *        (e.g., a TOPS-like server), with batched requests and a reply cache
+ * @author Peter Hakel
+ * @version 0.9
+ * @date Created on 16 October 2026\n
+ * Last modified on 17 October 2026
+ * @copyright (c) 2015, Triad National Security, LLC.
+ * All rights reserved.\n
+ * Use of this source code is governed by the BSD 3-Clause License.
+ * See top-level license.txt file for full license text.
+ */
+
+#include <Database.h>
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+/// Material state of one Zone, as sent to an OpacityProvider
+struct OpacityRequest
+{
+    /// Material file handles (from Table::get_F)
+    std::vector<std::string> mat;
+
+    /// Fractional populations of materials
+    std::vector<double> fp;
+
+    /// Electron temperature (eV)
+    double te;
+
+    /// Radiation temperature (eV)
+    double tr;
+
+    /// Total particle number density (particles/cm3)
+    double np;
+
+    /**
+     * @brief Ordering for the request batch and the reply cache
+     * @param[in] o OpacityRequest to compare against
+     * @return true, if *this precedes o
+     */
+    bool operator < (const OpacityRequest &o) const;
+};
+
+//-----------------------------------------------------------------------------
+
+/// Mixed optical data for one OpacityRequest, as in Zone::load_spectra
+struct OpacityReply
+{
+    /// Electron number density (electrons/cm3)
+    double ne;
+
+    /// Mixed monochromatic emissivity ( W / cm3 / sr / eV )
+    std::vector<double> em;
+
+    /// Mixed monochromatic absorption ( 1 / cm )
+    std::vector<double> ab;
+
+    /// Mixed monochromatic scattering ( 1 / cm )
+    std::vector<double> sc;
+};
+
+//-----------------------------------------------------------------------------
+
+/** @brief Source of mixed Zone optical data outside of the Database
+ *
+ * All distinct Zone states of a time step are sent in one batch, i.e., in
+ * one round trip to the server; replies are cached until the next batch, so
+ * that states repeated within a time step, or by the next one, are not sent
+ * again. Protocol (text, one batch per round trip):\n
+ * request: "batch n jmin jmax", then n lines
+ * "nmat mat_1 fp_1 ... mat_nmat fp_nmat te tr np";\n
+ * reply: "reply n nhv", then n lines "ne em[nhv] ab[nhv] sc[nhv]", then "end"
+ */
+class OpacityProvider
+{
+public:
+
+    /**
+     * @brief Parametrized constructor
+     * @param[in] jmin_in Lower index of the photon energy grid of the replies
+     * @param[in] jmax_in Upper index of the photon energy grid of the replies
+     */
+    OpacityProvider(const size_t jmin_in, const size_t jmax_in);
+
+    /// Destructor
+    virtual ~OpacityProvider();
+
+    /**
+     * @brief Getter for the lower photon energy index (OpacityProvider::jmin)
+     * @return Lower index of the photon energy grid of the replies
+     */
+    size_t get_jmin() const;
+
+    /**
+     * @brief Getter for the upper photon energy index (OpacityProvider::jmax)
+     * @return Upper index of the photon energy grid of the replies
+     */
+    size_t get_jmax() const;
+
+    /**
+     * @brief Sends all requests not yet in the reply cache to the server,
+     *        in one round trip; cached replies not requested by rq are
+     *        dropped
+     * @param[in] rq Requests (repeated entries are sent once)
+     */
+    void request(const std::vector<OpacityRequest> &rq);
+
+    /**
+     * @brief Retrieves a cached reply
+     * @param[in] r Request, already passed to request()
+     * @return Reply to r
+     */
+    const OpacityReply & reply(const OpacityRequest &r) const;
+
+    /**
+     * @brief Getter for the number of round trips to the server
+     * @return Number of batches sent
+     */
+    size_t get_ntrips() const;
+
+    /**
+     * @brief Getter for the number of requests sent to the server
+     * @return Number of distinct requests sent
+     */
+    size_t get_nsent() const;
+
+    /**
+     * @brief Getter for the number of requests answered from the cache
+     * @return Number of requests not sent to the server
+     */
+    size_t get_nhits() const;
+
+    /**
+     * @brief Getter for the number of cached replies
+     * @return Number of distinct requests of the last request() call
+     */
+    size_t get_cache_size() const;
+
+    /**
+     * @brief Summary of the traffic to the server
+     * @return Round trips, requests sent, cache hits
+     */
+    std::string to_string() const;
+
+    /**
+     * @brief Writes one batch of requests in the protocol format
+     * @param[in] rq Requests
+     * @param[in] jmin Lower index of the photon energy grid
+     * @param[in] jmax Upper index of the photon energy grid
+     * @return Batch message
+     */
+    static std::string write_batch(const std::vector<OpacityRequest> &rq,
+                                   const size_t jmin, const size_t jmax);
+
+    /**
+     * @brief Reads the replies to one batch in the protocol format
+     * @param[in] msg Reply message
+     * @param[in] n Number of requests in the batch
+     * @param[in] nhv Number of photon energy points per spectrum
+     * @return Replies, in the order of the batch
+     */
+    static std::vector<OpacityReply> read_reply(const std::string &msg,
+                                                const size_t n,
+                                                const size_t nhv);
+
+    /**
+     * @brief Server side: answers batches from a text Database until the
+     *        end of input, flushing each reply
+     * @param[in] d Database (text or packed, not TOPS)
+     * @param[in,out] in Input stream of batches
+     * @param[in,out] out Output stream of replies
+     * @return Number of batches answered
+     */
+    static size_t serve(const Database &d, std::istream &in,
+                        std::ostream &out);
+
+
+protected:
+
+    /**
+     * @brief Sends one batch to the server and waits for its reply
+     * @param[in] batch Batch message (see write_batch)
+     * @return Reply message, up to and including "end"
+     */
+    virtual std::string round_trip(const std::string &batch) = 0;
+
+
+private:
+
+    /// Lower index of the photon energy grid of the replies
+    size_t jmin;
+
+    /// Upper index of the photon energy grid of the replies
+    size_t jmax;
+
+    /// Replies to the requests of the last request() call
+    std::map<OpacityRequest, OpacityReply> cache;
+
+    /// Number of batches sent
+    size_t ntrips;
+
+    /// Number of distinct requests sent
+    size_t nsent;
+
+    /// Number of requests answered from OpacityProvider::cache
+    size_t nhits;
+};
+
+//-----------------------------------------------------------------------------
+
+#endif  // LANL_ASC_PEM_OPACITYPROVIDER_H_
@@ -0,0 +1,154 @@
+/**
+ * @file PipeProvider.cpp
+ * @brief OpacityProvider served by a local subprocess over a pair of pipes
+ * @author Peter Hakel
+ * @version 0.9
+ * @date Created on 16 October 2026\n
+ * Last modified on 17 October 2026
+ * @copyright (c) 2015, Triad National Security, LLC.
+ * All rights reserved.\n
+ * Use of this source code is governed by the BSD 3-Clause License.
+ * See top-level license.txt file for full license text.
+ */
+
+#include <PipeProvider.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+
+#ifndef WIN
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+PipeProvider::PipeProvider(const std::string &cmnd_in,
+                           const size_t jmin_in, const size_t jmax_in):
+    OpacityProvider(jmin_in, jmax_in), cmnd(cmnd_in),
+    pid(-1), to_fd(-1), from_fd(-1)
+{
+#ifdef WIN
+    std::cerr << "Error: opacity server " << cmnd << " cannot be started "
+              << "(no pipes on Windows) in PipeProvider::PipeProvider"
+              << std::endl;
+    exit(EXIT_FAILURE);
+#else
+    int p_in[2], p_out[2]; // server's standard input, output
+    if (pipe(p_in) != 0  ||  pipe(p_out) != 0)
+    {
+        std::cerr << "Error: no pipes for opacity server " << cmnd
+                  << " in PipeProvider::PipeProvider" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    signal(SIGPIPE, SIG_IGN); // a dead server shows up as a write error
+    pid = fork();
+    if (pid < 0)
+    {
+        std::cerr << "Error: opacity server " << cmnd << " cannot be started "
+                  << "in PipeProvider::PipeProvider" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (pid == 0) // child: becomes the server
+    {
+        dup2(p_in[0], STDIN_FILENO);
+        dup2(p_out[1], STDOUT_FILENO);
+        close(p_in[0]);
+        close(p_in[1]);
+        close(p_out[0]);
+        close(p_out[1]);
+        execl("/bin/sh", "sh", "-c", cmnd.c_str(), static_cast<char *>(nullptr));
+        _exit(127);
+    }
+    close(p_in[0]);
+    close(p_out[1]);
+    to_fd = p_in[1];
+    from_fd = p_out[0];
+    fcntl(to_fd, F_SETFL, fcntl(to_fd, F_GETFL) | O_NONBLOCK);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+PipeProvider::~PipeProvider()
+{
+#ifndef WIN
+    if (to_fd >= 0) close(to_fd); // end of input: the server exits
+    if (from_fd >= 0) close(from_fd);
+    if (pid > 0) waitpid(pid, nullptr, 0);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+std::string PipeProvider::get_cmnd() const
+{
+    return cmnd;
+}
+
+//-----------------------------------------------------------------------------
+
+std::string PipeProvider::round_trip(const std::string &batch)
+{   // the server replies while it reads: write and read interleaved, so
+    // that neither side blocks on a full pipe
+    std::string msg("");
+#ifndef WIN
+    const std::string END("\nend\n");
+    const char *p = batch.data();
+    size_t left = batch.size();
+    char buf[65536];
+    while (left > 0  ||  msg.size() < END.size()  ||
+           msg.compare(msg.size() - END.size(), END.size(), END) != 0)
+    {
+        struct pollfd fds[2];
+        fds[0].fd = from_fd;
+        fds[0].events = POLLIN;
+        fds[1].fd = to_fd;
+        fds[1].events = POLLOUT;
+        fds[0].revents = fds[1].revents = 0;
+        if (poll(fds, left > 0 ? 2 : 1, -1) < 0)
+        {
+            if (errno == EINTR) continue;
+            std::cerr << "Error: poll failed for opacity server " << cmnd
+                      << " in PipeProvider::round_trip" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        if (left > 0  &&  fds[1].revents != 0)
+        {   // to_fd is non-blocking: writes only what fits in the pipe
+            ssize_t k = write(to_fd, p, left);
+            if (k < 0  &&  (errno == EINTR  ||  errno == EAGAIN)) continue;
+            if (k <= 0)
+            {
+                std::cerr << "Error: cannot write to opacity server " << cmnd
+                          << " in PipeProvider::round_trip" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            p += k;
+            left -= static_cast<size_t>(k);
+        }
+
+        if (fds[0].revents != 0)
+        {
+            ssize_t k = read(from_fd, buf, sizeof(buf));
+            if (k < 0  &&  errno == EINTR) continue;
+            if (k <= 0)
+            {
+                std::cerr << "Error: opacity server " << cmnd << " closed its "
+                          << "output in PipeProvider::round_trip" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            msg.append(buf, static_cast<size_t>(k));
+        }
+    }
+#endif
+    return msg;
+}
+
+//-----------------------------------------------------------------------------
+
+//  end PipeProvider.cpp
@@ -0,0 +1,94 @@
+#ifndef LANL_ASC_PEM_PIPEPROVIDER_H_
+#define LANL_ASC_PEM_PIPEPROVIDER_H_
+
+/**
+ * @file PipeProvider.h
+ * @brief OpacityProvider served by a local subprocess over a pair of pipes
+ * @author Peter Hakel
+ * @version 0.9
+ * @date Created on 16 October 2026\n
+ * Last modified on 17 October 2026
+ * @copyright (c) 2015, Triad National Security, LLC.
+ * All rights reserved.\n
+ * Use of this source code is governed by the BSD 3-Clause License.
+ * See top-level license.txt file for full license text.
+ */
+
+#include <OpacityProvider.h>
+
+#include <string>
+
+//-----------------------------------------------------------------------------
+
+/** @brief OpacityProvider served by a local subprocess over a pair of pipes
+ *
+ * The command (e.g., TOPS_command from the options file) is started once
+ * through /bin/sh; it reads batches on its standard input and writes replies
+ * on its standard output (see OpacityProvider, OpacityServer/).
+ * Closing its standard input, in the destructor, ends the subprocess.
+ */
+class PipeProvider: public OpacityProvider
+{
+public:
+
+    /**
+     * @brief Parametrized constructor: starts the server subprocess
+     * @param[in] cmnd_in Shell command that starts the server
+     * @param[in] jmin_in Lower index of the photon energy grid of the replies
+     * @param[in] jmax_in Upper index of the photon energy grid of the replies
+     */
+    PipeProvider(const std::string &cmnd_in,
+                 const size_t jmin_in, const size_t jmax_in);
+
+    /**
+     * @brief Copy constructor
+     * @param[in] o PipeProvider object to be copied (deleted, owns the pipes)
+     */
+    PipeProvider(const PipeProvider &o) = delete;
+
+    /**
+     * @brief Overloaded assignment operator
+     * @param[in] o PipeProvider object to be copied (deleted, owns the pipes)
+     * @return Reference to copied object
+     */
+    PipeProvider &operator=(const PipeProvider &o) = delete;
+
+    /// Destructor: closes the pipes and waits for the server to exit
+    ~PipeProvider() override;
+
+    /**
+     * @brief Getter for the server command (PipeProvider::cmnd)
+     * @return Shell command that started the server
+     */
+    std::string get_cmnd() const;
+
+
+protected:
+
+    /**
+     * @brief Sends one batch to the server and waits for its reply;
+     *        the reply is read while the batch is still being written
+     * @param[in] batch Batch message (see OpacityProvider::write_batch)
+     * @return Reply message, up to and including "end"
+     */
+    std::string round_trip(const std::string &batch) override;
+
+
+private:
+
+    /// Shell command that started the server
+    std::string cmnd;
+
+    /// Process ID of the server
+    int pid;
+
+    /// File descriptor of the pipe to the server's standard input
+    int to_fd;
+
+    /// File descriptor of the pipe from the server's standard output
+    int from_fd;
+};
+
+//-----------------------------------------------------------------------------
+
+#endif  // LANL_ASC_PEM_PIPEPROVIDER_H_
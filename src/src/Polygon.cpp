@@ -4,7 +4,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 21 November 2014\n
- * Last modified on 24 February 2020
+ * Last modified on 16 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -20,22 +20,24 @@
 //-----------------------------------------------------------------------------
 
 // X: node index local to *this; range: 0 through size()-1
-#define NODE(X)     g.get_node(get_node((X)))
-#define POINT(X)    NODE((X)).getr()
-#define VELOCITY(X) NODE((X)).getv()
+#define POINT(X)    g.getr(get_node((X)))
+#define VELOCITY(X) g.getv(get_node((X)))
 
 //-----------------------------------------------------------------------------
 
-Polygon::Polygon(): Face() {}
+Polygon::Polygon(): Face(), geo_stamp(0), geo_n(), geo_d(0.0), geo_o(),
+    geo_x(), geo_y(), geo_edge() {}
 
 //-----------------------------------------------------------------------------
 
 Polygon::Polygon(const size_t my_zone_in, const short int my_id_in):
-    Face(my_zone_in, my_id_in) {}
+    Face(my_zone_in, my_id_in), geo_stamp(0), geo_n(), geo_d(0.0), geo_o(),
+    geo_x(), geo_y(), geo_edge() {}
 
 //-----------------------------------------------------------------------------
 
-Polygon::Polygon(std::ifstream &istr)
+Polygon::Polygon(std::ifstream &istr): geo_stamp(0), geo_n(), geo_d(0.0),
+    geo_o(), geo_x(), geo_y(), geo_edge()
 {
     load(istr);
 }
@@ -68,6 +70,7 @@ void Polygon::load(std::ifstream &istr)
     size_t nnodes;
     istr >> nnodes;
     load_face(istr, nnodes);
+    geo_stamp = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -104,6 +107,7 @@ Vector3d Polygon::area2_normal_center(const Grid &g, Vector3d &c) const
 
 Vector3d Polygon::normal(const Grid &g) const
 {
+    if (is_compiled(g)) return geo_n;
     Vector3d c;
     return area2_normal_center(g, c).normalize();
 }
@@ -155,6 +159,29 @@ bool Polygon::contains(const Grid &g, const Vector3d &w) const
     int first_turn = NOT_INITIALIZED;
     int turn;
 
+    if (is_compiled(g))
+    {   // same arithmetic as below (Vector3d::get_turn), from compile()
+        const Vector3d p = w - geo_o;
+        const double qx = p * geo_x;
+        const double qy = p * geo_y;
+        const double small = Vector3d::get_small();
+        const double *e = geo_edge.data();
+        const size_t n = geo_edge.size() / 4;
+        for (size_t j = 0; j < n; ++j, e += 4)
+        {
+            const double wvz = e[2] * (qy - e[1])  -  e[3] * (qx - e[0]);
+            turn = utils::sign_eqt(wvz, small);
+            if (turn != 0)
+            {
+                if (first_turn == NOT_INITIALIZED)
+                    first_turn = turn;
+                else if (first_turn != turn)
+                    return false;
+            }
+        }
+        return true;
+    }
+
     // build local coordinate system in the plane of *this
     const Vector3d Zhat = normal(g);
     const Vector3d origin = POINT(0);
@@ -216,11 +243,11 @@ RetIntercept Polygon::intercept(const Grid &g, const Vector3d &p,
     }
     else
     {
-        const Vector3d a = POINT(0);
-        const double numerator = (a - p) * n;
+        const double numerator = is_compiled(g) ? geo_d - p * n
+                                                : (POINT(0) - p) * n;
         rv.t = numerator / denominator; // Eq.(3)
         rv.w = p  +  u * rv.t; // Eq.(2)
-        rv.is_found = utils::sign_eqt(rv.t, eqt) == 1  &&  contains(g, rv.w);
+        rv.is_found = utils::sign_eqt(rv.t, eqt) == 1  &&  crosses(g, p, u);
     }
 
     return rv;
@@ -228,6 +255,67 @@ RetIntercept Polygon::intercept(const Grid &g, const Vector3d &p,
 
 //-----------------------------------------------------------------------------
 
+bool Polygon::crosses(const Grid &g, const Vector3d &p, const Vector3d &u)
+    const
+{
+    int first_turn = 0;
+    const size_t n = size();
+    Vector3d tail = POINT(n-1) - p;
+    for (size_t j = 0; j < n; ++j)
+    {   // side from Node j-1 to Node j, as seen from p
+        const Vector3d head = POINT(j) - p;
+        const double s = u * (tail % head);
+        const int turn = (s > 0.0) - (s < 0.0); // exact; no tolerance
+        if (turn != 0)
+        {
+            if (first_turn == 0)
+                first_turn = turn;
+            else if (first_turn != turn)
+                return false;
+        }
+        tail = head;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void Polygon::compile(const Grid &g)
+{
+    geo_stamp = 0; // normal() below must not use stale data
+    geo_n = normal(g);
+    geo_o = POINT(0);
+    geo_d = geo_n * geo_o;
+    geo_x = (POINT(1) - geo_o).normalize();
+    geo_y = geo_n % geo_x;
+    const size_t n = size();
+    geo_edge.resize(4 * n);
+    for (size_t j = 0; j < n; ++j)
+    {
+        size_t i = j + 1;
+        if (i == n) i = 0;
+        const Vector3d head3d = POINT(i) - geo_o;
+        const Vector3d tail3d = POINT(j) - geo_o;
+        const Vector3d head(head3d*geo_x, head3d*geo_y, 0.0);
+        const Vector3d tail(tail3d*geo_x, tail3d*geo_y, 0.0);
+        const Vector3d side = head - tail;
+        geo_edge[4*j]   = tail.getx();
+        geo_edge[4*j+1] = tail.gety();
+        geo_edge[4*j+2] = side.getx();
+        geo_edge[4*j+3] = side.gety();
+    }
+    geo_stamp = g.get_stamp();
+}
+
+//-----------------------------------------------------------------------------
+
+bool Polygon::is_compiled(const Grid &g) const
+{
+    return geo_stamp != 0  &&  geo_stamp == g.get_stamp();
+}
+
+//-----------------------------------------------------------------------------
+
 Vector3d Polygon::velocity(const Grid &g, const Vector3d &w) const
 {
     const double SMALL = Vector3d::get_small();
@@ -249,7 +337,6 @@ Vector3d Polygon::velocity(const Grid &g, const Vector3d &w) const
 
 #undef VELOCITY
 #undef POINT
-#undef NODE
 
 //-----------------------------------------------------------------------------
 
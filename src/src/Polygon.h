@@ -7,7 +7,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 21 November 2014\n
- * Last modified on 24 February 2020
+ * Last modified on 16 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -84,11 +84,62 @@ public:
      */
     bool contains(const Grid &g, const Vector3d &w) const override;
 
+    /**
+     * @brief Flags whether a Ray crosses *this Polygon (watertight test)
+     *
+     * The sign of u * ((a - p) % (b - p)) is evaluated for every side (a, b)
+     * directly from the Node positions, not from a computed hit-point. Two
+     * Polygons sharing a side get bit-for-bit opposite values for it, so a
+     * Ray cannot pass between them; an exactly zero value (Ray through the
+     * side's line) counts as inside for both (tie-break by smaller t in
+     * Zone::hit).
+     * @param[in] g Grid of Node objects
+     * @param[in] p Ray starting point
+     * @param[in] u Ray velocity
+     * @return "true" or "false"
+     * @todo Generalize this method to handle non-convex Polygon objects
+     */
+    bool crosses(const Grid &g, const Vector3d &p, const Vector3d &u) const;
+
     RetIntercept intercept(const Grid &g, const Vector3d &p,
                            const Vector3d &u, const double eqt,
                            const FaceID &fid) const override;
 
+    void compile(const Grid &g) override;
+
     Vector3d velocity(const Grid &g, const Vector3d &w) const override;
+
+
+private:
+
+    /// Grid::get_stamp of the compiled geometry (0: not compiled)
+    size_t geo_stamp;
+
+    /// Unit normal, as returned by normal()
+    Vector3d geo_n;
+
+    /// Plane constant: geo_n * (first Node)
+    double geo_d;
+
+    /// First Node: origin of the in-plane frame
+    Vector3d geo_o;
+
+    /// In-plane unit vector along the first side
+    Vector3d geo_x;
+
+    /// In-plane unit vector completing the frame (geo_n % geo_x)
+    Vector3d geo_y;
+
+    /// Per side, in the in-plane frame: tail x, tail y, (head - tail) x,
+    /// (head - tail) y
+    std::vector<double> geo_edge;
+
+    /**
+     * @brief Flags whether the compiled geometry belongs to g
+     * @param[in] g Grid of Node objects
+     * @return true, if compile(g) was called since g last changed
+     */
+    bool is_compiled(const Grid &g) const;
 };
 
 //-----------------------------------------------------------------------------
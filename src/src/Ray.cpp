@@ -4,7 +4,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 24 December 2014\n
- * Last modified on 8 October 2020
+ * Last modified on 17 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -27,37 +27,20 @@
 
 //-----------------------------------------------------------------------------
 
-Waypoint::Waypoint(): outface(), inface(), hitpt() {}
-
-//-----------------------------------------------------------------------------
-
-Waypoint::Waypoint(const Vector3d &hp):
-    outface(Face::BOUNDING_SPHERE), inface(Face::BOUNDING_SPHERE), hitpt(hp) {}
-
-//-----------------------------------------------------------------------------
-
-Waypoint::Waypoint(const FaceID &oface, const FaceID &iface,
-                   const Vector3d &hp):
-    outface(oface), inface(iface), hitpt(hp) {}
-
-//-----------------------------------------------------------------------------
-
-void Ray::init(const size_t nin, const Vector3d &rin)
+void Ray::init(const size_t nin)
 {
     em.assign(nin, 0.0);
     ab.assign(nin, 0.0);
     sc.assign(nin, 0.0);
-    Waypoint w(rin);
-    wpt.push(w);
 }
 
 //-----------------------------------------------------------------------------
 
-Ray::Ray(): diag_id(-1), patch_id(0, 0), bundle_id(0, 0),
-    r(), v(), analysis(false), zid(Zone::BOUNDING_ZONE), y(), wpt(),
+Ray::Ray(): diag_id(-1), patch_id(0, 0), bundle_id(0, 0), band_id(SIZE_MAX),
+    r(), v(), analysis(false), zid(Zone::BOUNDING_ZONE), y(), path(),
     ite(0), itr(0), ine(0), em(), ab(), sc(),
     level(0), freq(0), n(0), jmin(0), jmax(0), nzones(0), nzd(0),
-    iz(0), distance(0.0), tracking(false), froot(""), hroot("") {}
+    iz(0), distance(0.0), rend(), tracking(false), froot(""), hroot("") {}
 
 //-----------------------------------------------------------------------------
 
@@ -65,15 +48,17 @@ Ray::Ray(const int level_in, const size_t freq_in, const size_t nin,
          const size_t jmin_in, const size_t jmax_in, const bool tracking_in,
          const Vector3d &rin, const Vector3d &vin, const bool analysis_in,
          const std::string &froot_in, const std::string &hroot_in):
-    diag_id(-1), patch_id(0, 0), bundle_id(0, 0), r(rin), v(vin),
-    analysis(analysis_in), zid(Zone::BOUNDING_ZONE), y(), wpt(), ite(0), itr(0),
+    diag_id(-1), patch_id(0, 0), bundle_id(0, 0), band_id(SIZE_MAX),
+    r(rin), v(vin),
+    analysis(analysis_in), zid(Zone::BOUNDING_ZONE), y(), path(), ite(0), itr(0),
     ine(0), em(), ab(), sc(),
     level(level_in), freq(freq_in), n(nin), jmin(jmin_in), jmax(jmax_in),
-    nzones(0), nzd(0), iz(0), distance(0.0), tracking(tracking_in),
+    nzones(0), nzd(0), iz(0), distance(0.0), rend(rin),
+    tracking(tracking_in),
     froot(froot_in), hroot(hroot_in)
 {
     y.assign(nin, 0.0);
-    init(nin, rin);
+    init(nin);
 }
 
 //-----------------------------------------------------------------------------
@@ -83,12 +68,14 @@ Ray::Ray(const int level_in, const size_t freq_in, const size_t nin,
          const Vector3d &rin, const Vector3d &vin, const bool analysis_in,
          const ArrDbl &yin,
          const std::string &froot_in, const std::string &hroot_in):
-    diag_id(-1), patch_id(0, 0), bundle_id(0, 0), r(rin), v(vin),
-    analysis(analysis_in), zid(Zone::BOUNDING_ZONE), y(yin), wpt(), ite(0),
+    diag_id(-1), patch_id(0, 0), bundle_id(0, 0), band_id(SIZE_MAX),
+    r(rin), v(vin),
+    analysis(analysis_in), zid(Zone::BOUNDING_ZONE), y(yin), path(), ite(0),
     itr(0), ine(0), em(), ab(), sc(),
     level(level_in), freq(freq_in), n(nin), jmin(jmin_in), jmax(jmax_in),
-    nzones(0), nzd(0), iz(0), distance(0.0), tracking(tracking_in),
-    froot(froot_in), hroot(hroot_in) {init(nin, rin);}
+    nzones(0), nzd(0), iz(0), distance(0.0), rend(rin),
+    tracking(tracking_in),
+    froot(froot_in), hroot(hroot_in) {init(nin);}
 
 //-----------------------------------------------------------------------------
 
@@ -131,22 +118,37 @@ void Ray::set_backlighter(const std::vector<double> &yb)
 void Ray::trace(const Grid &g, const Mesh &m)
 {
     Progress counter("Ray_trace", level, 0, freq, "", std::cout);
-    counter.advance(); // final b.Sphere waypoint already pushed onto RayStack
+    counter.advance(); // crossing of the bounding Sphere Zone is traced first
     RetIntercept intrcpt;
-    Waypoint w;
-    w.outface = wpt.top().outface;
+    FaceID outface(Face::BOUNDING_SPHERE);
+    path.clear();
+    rend = r;
+    const Block &b = m.get_block();
+    if (b.size() > 0) // structured Block: DDA, then out through Zone 0
+    {
+        const Vector3d q = r  +  v * (b.traverse(r, v / v.norm(), path)
+                                      / v.norm());
+        intrcpt = m.hit(g, Zone::BOUNDING_ZONE, q, v, outface);
+        path.push_back(Chord{Zone::BOUNDING_ZONE, (q - intrcpt.w).norm()});
+        r = intrcpt.w;
+        zid = Zone::BOUNDING_ZONE;
+        if (tracking) nzones += path.size();
+        nzd = utils::ndigits(nzones);
+        v.reverse();
+        return;
+    }
     while (true)
     {
         if (tracking) ++nzones;
-        auto z = m.get_zone(zid);
-        intrcpt = z->hit(g, r, v, w.outface);
-        w.hitpt = intrcpt.w;
-        w.inface = intrcpt.fid;
-        w.outface = m.next_face(g, intrcpt);
-        r = w.hitpt;
-        if (w.inface == Face::BOUNDING_SPHERE) break;
-        zid = w.outface.my_zone;
-        wpt.push(w);
+        intrcpt = m.hit(g, zid, r, v, outface);
+        outface = m.next_face(g, intrcpt);
+        Chord c;
+        c.zid = zid;
+        c.ct = (r - intrcpt.w).norm(); // chord length across Zone zid
+        path.push_back(c);
+        r = intrcpt.w;
+        if (intrcpt.fid == Face::BOUNDING_SPHERE) break;
+        zid = outface.my_zone;
         counter.advance();
     }
     nzd = utils::ndigits(nzones);
@@ -155,15 +157,61 @@ void Ray::trace(const Grid &g, const Mesh &m)
 
 //-----------------------------------------------------------------------------
 
+RayPath Ray::get_path() const
+{
+    RayPath p;
+    p.path = path;
+    p.r = r;
+    p.v = v;
+    p.zid = zid;
+    p.nzones = nzones;
+    return p;
+}
+
+//-----------------------------------------------------------------------------
+
+void Ray::set_path(const RayPath &p)
+{
+    path = p.path;
+    r = p.r;
+    v = p.v;
+    zid = p.zid;
+    nzones = p.nzones;
+    nzd = utils::ndigits(nzones);
+}
+
+//-----------------------------------------------------------------------------
+
 void Ray::transport(const double ct) // transport this->y across *this
 {
-    // Optically-thin formula used for optical depth < 2.0e-10
-    const double TR_THIN = exp(-2.0e-10);
 /*
     #ifdef OMP
     #pragma omp simd
     #endif
 */
+    #ifdef SINGLE
+    // Optically-thin formula used for optical depth < 1.0e-6; in float,
+    // 1 - tr loses all digits at small optical depth, hence expm1.
+    // em, ab, sc, y are double arrays (as many bytes read as without
+    // SINGLE); only the arithmetic is float, matching the cached spectra.
+    const SpecReal TAU_THIN = 1.0e-6f;
+    const SpecReal ctf = static_cast<SpecReal>(ct);
+    for (size_t i = 0; i < n; ++i)
+    {
+        SpecReal emf = static_cast<SpecReal>(em[i]);
+        SpecReal op = static_cast<SpecReal>(ab[i] + sc[i]); // opacity
+        SpecReal tau = op * ctf;         // optical depth
+        SpecReal tr = std::exp(-tau);    // transmission
+        SpecReal se;                     // self_emission
+        if (tau < TAU_THIN)
+            se = emf * ctf; // optically thin limit in 1-D
+        else
+            se = -std::expm1(-tau) * emf / op; // general 1-D solution
+        y[i] = y[i] * tr + se; // transmitted_backlighter + self_emission
+    }
+    #else
+    // Optically-thin formula used for optical depth < 2.0e-10
+    const double TR_THIN = exp(-2.0e-10);
     for (size_t i = 0; i < n; ++i)
     {
         double op = ab[i] + sc[i];       // opacity
@@ -175,25 +223,30 @@ void Ray::transport(const double ct) // transport this->y across *this
             se = (1.0 - tr) * em[i] / op; // general 1-D solution
         y[i] = y[i] * tr + se; // transmitted_backlighter + self_emission
     }
+    #endif
 }
 
 //-----------------------------------------------------------------------------
 
-void Ray::cross_Zone(ZonePtr z, const Database &d, const Table &tbl,
+void Ray::cross_Zone(Zone &z, const Database &d, const Table &tbl,
                      const std::string &symmetry, const size_t ix,
                      const int ndmesh)
 {   // assumes that this->zid has already been set; e.g., in cross_Mesh()
-    const Waypoint &w = wpt.top();
-    const Vector3d r_old = r;
-    r = w.hitpt;
-    const double ct = (r - r_old).norm(); // chord length across current Zone
-    if (d.get_tops_cmnd() == "none")
+    const double ct = path.back().ct; // chord length across current Zone
+    r += v * (ct / v.norm());
+    if (band_id != SIZE_MAX) // band-averaged mode
+    {
+        z.load_bands(d, tbl, ite, itr, ine, band_id, n, em, ab, sc);
+        transport(ct);
+    }
+    else if (d.get_tops_cmnd() == "none"  ||  z.is_mixed()) // TOPS: provided
     {
-        z->load_spectra(d, tbl, ite, itr, ine, symmetry, ix, analysis,
+        z.load_spectra(d, tbl, ite, itr, ine, symmetry, ix, analysis,
                         jmin, jmax, em, ab, sc);
         transport(ct);
     }
-    wpt.pop();
+    path.pop_back();
+    if (path.empty()) r = rend; // exact, not accumulated from the chords
 
     if (tracking)
     {
@@ -203,7 +256,7 @@ void Ray::cross_Zone(ZonePtr z, const Database &d, const Table &tbl,
         std::string header(hroot);
         utils::replace_in_string(header, "\n", "_"+izlabel+"\n");
         header += "\n" + izstring + utils::double_to_string(distance) + " cm";
-        header += "\nZoneID " + utils::int_to_string(z->get_id(), ' ', ndmesh);
+        header += "\nZoneID " + utils::int_to_string(z.get_id(), ' ', ndmesh);
         header += "\ndata in W/cm2/sr/eV";
         std::string fname(froot + "_" + izlabel + ".txt");
         y.to_file(fname, header);
@@ -216,11 +269,11 @@ void Ray::cross_Zone(ZonePtr z, const Database &d, const Table &tbl,
 void Ray::cross_Mesh(const Mesh &m, const Database &d, const Table &tbl,
                      const std::string &symmetry, const size_t ix)
 {
-    Progress counter("Ray_transport", level, wpt.size(), freq, "", std::cout);
-    while ( !wpt.empty() )
+    Progress counter("Ray_transport", level, path.size(), freq, "", std::cout);
+    while ( !path.empty() )
     {
-        zid = wpt.top().outface.my_zone;
-        cross_Zone(m.get_zone(zid), d, tbl, symmetry, ix,
+        zid = path.back().zid;
+        cross_Zone(m.zone_at(zid), d, tbl, symmetry, ix,
                    utils::ndigits(m.size()));
         counter.advance();
     }
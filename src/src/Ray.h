@@ -7,7 +7,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 24 December 2014\n
- * Last modified on 6 October 2020
+ * Last modified on 16 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -17,48 +17,33 @@
 #include <Grid.h>
 #include <Mesh.h>
 
+#include <cstdint>
 #include <iostream>
-#include <stack>
 #include <string>
 #include <utility>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 
-/// Auxiliary structure for Ray-tracing
-struct Waypoint
+/// Result of Ray::trace, reusable while the Mesh geometry is unchanged
+struct RayPath
 {
-    /// Face hit by Ray on exit from Zone
-    FaceID outface;
+    /// Ray trajectory through Mesh (Ray::path)
+    ChordPath path;
 
-    /// Face hit by Ray on entry into Zone
-    FaceID inface;
-
-    /// Hitpoint (intercept) = location of *this Waypoint
-    Vector3d hitpt;
+    /// Ray position at the end of tracing (Ray::r)
+    Vector3d r;
 
-    /// Default constructor
-    Waypoint();
+    /// Ray velocity at the end of tracing (Ray::v)
+    Vector3d v;
 
-    /**
-     * @brief Parametrized constructor
-     * @param[in] hp Initializes location of *this Waypoint (Waypoint::hitpt)
-     */
-    explicit Waypoint(const Vector3d &hp);
+    /// ID of the last Zone traced (Ray::zid)
+    size_t zid;
 
-    /**
-     * @brief Parametrized constructor
-     * @param[in] oface Initializes Waypoint::outface
-     * @param[in] iface Initializes Waypoint::inface
-     * @param[in] hp Initializes location of *this Waypoint (Waypoint::hitpt)
-     */
-    Waypoint(const FaceID &oface, const FaceID &iface, const Vector3d &hp);
+    /// Number of Zones crossed, if tracking (Ray::nzones)
+    size_t nzones;
 };
 
-//-----------------------------------------------------------------------------
-
-/// Ray path
-typedef std::stack<Waypoint> RayStack;
-
 /// Integer labels for Detector use: first -> theta,x, second -> phi,y
 typedef std::pair<size_t, size_t> IntPair;
 
@@ -81,6 +66,10 @@ public:
     /// ID of direction from which *this Ray hits its Detector patch
     IntPair bundle_id;
 
+    /// BandSet index (Database::band_index) in band-averaged mode;
+    /// SIZE_MAX for monochromatic transport
+    size_t band_id;
+
     /// Current Ray position
     Vector3d r;
 
@@ -96,8 +85,8 @@ public:
     /// Current Ray specific intensity in W / cm2 / sr / eV
     ArrDbl y;
 
-    /// Ray trajectory through Mesh as a sequence of Waypoint objects
-    RayStack wpt;
+    /// Ray trajectory through Mesh as a sequence of Chord objects
+    ChordPath path;
 
     /// Electron temperature Database access index saved from previous Zone
     size_t ite;
@@ -194,12 +183,28 @@ public:
     void set_backlighter(const std::vector<double> &yb);
 
     /**
-     * @brief Ray tracing -> builds Ray::wpt stack of Waypoint objects
+     * @brief Ray tracing -> builds Ray::path of Chord objects; the cells
+     *        of a structured Block are crossed by Block::traverse
      * @param[in] g Grid of Node objects
      * @param[in] m Mesh of Zone objects
      */
     void trace(const Grid &g, const Mesh &m);
 
+    /**
+     * @brief Getter for the result of trace()
+     * @return Path of *this Ray; call before cross_Mesh() consumes
+     *         Ray::path
+     */
+    RayPath get_path() const;
+
+    /**
+     * @brief Restores the result of an earlier trace() on the same geometry,
+     *        instead of calling trace()
+     * @param[in] p Path from get_path() of a Ray with the same initial
+     *            position and velocity
+     */
+    void set_path(const RayPath &p);
+
     /**
      * @brief Apply 1D analytic transport solution to update Ray::y
      * @param[in] ct Ray chord length across current Zone
@@ -218,7 +223,7 @@ public:
      * @param[in] ndmesh Number of digits needed to represent the total
                   number of Zones in the Mesh
      */
-    void cross_Zone(ZonePtr z, const Database &d, const Table &tbl,
+    void cross_Zone(Zone &z, const Database &d, const Table &tbl,
                     const std::string &symmetry, const size_t ix,
                     const int ndmesh);
 
@@ -270,6 +275,9 @@ private:
     /// Current distance (cm) traveled by *this Ray
     double distance;
 
+    /// Ray position at the end of Ray::path (where trace() starts)
+    Vector3d rend;
+
     /// Tracking of partial results along *this Ray
     bool tracking;
 
@@ -282,9 +290,8 @@ private:
     /**
      * @brief Ray constructor helper
      * @param[in] nin Initializes sizes of Ray::em, Ray::ab, Ray::sc
-     * @param[in] rin Initializes Waypoint position (Ray::wpt)
      */
-    void init(const size_t nin, const Vector3d &rin);
+    void init(const size_t nin);
 };
 
 //-----------------------------------------------------------------------------
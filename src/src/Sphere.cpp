@@ -4,7 +4,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 21 November 2014\n
- * Last modified on 27 February 2020
+ * Last modified on 16 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -19,9 +19,8 @@
 //-----------------------------------------------------------------------------
 
 // X: node index local to *this; range: 0 through size()-1
-#define NODE(X)     g.get_node(get_node((X)))
-#define POINT(X)    NODE((X)).getr()
-#define VELOCITY(X) NODE((X)).getv()
+#define POINT(X)    g.getr(get_node((X)))
+#define VELOCITY(X) g.getv(get_node((X)))
 
 //-----------------------------------------------------------------------------
 
@@ -250,7 +249,6 @@ Vector3d Sphere::velocity(const Grid &g, const Vector3d &w) const
 
 #undef VELOCITY
 #undef POINT
-#undef NODE
 
 //-----------------------------------------------------------------------------
 
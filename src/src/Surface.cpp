@@ -4,7 +4,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 16 December 2014\n
- * Last modified on 27 February 2020
+ * Last modified on 16 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -75,6 +75,13 @@ FacePtr Surface::get_face(const size_t i) const
 
 //-----------------------------------------------------------------------------
 
+Face & Surface::face_at(const size_t i) const
+{
+    return *face[i];
+}
+
+//-----------------------------------------------------------------------------
+
 size_t Surface::size() const
 {
     return nfaces;
@@ -7,7 +7,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 16 December 2014\n
- * Last modified on 24 February 2020
+ * Last modified on 16 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -86,6 +86,14 @@ public:
      */
     FacePtr get_face(const size_t i) const;
 
+    /**
+     * @brief Non-owning access to the Face at given location in
+     *        Surface::face, for Ray traversal
+     * @param[in] i Index of Face within *this Surface (not range-checked)
+     * @return Reference to Face
+     */
+    Face & face_at(const size_t i) const;
+
     size_t size() const override;
 
     /**
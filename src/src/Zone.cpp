@@ -4,7 +4,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 8 December 2014\n
- * Last modified on 6 October 2020
+ * Last modified on 17 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -29,19 +29,28 @@
 
 Zone::Zone():
     my_id(0), face(), te(-1.0), tr(-1.0),
-    np(-1.0), nmat(0), mat(), fp(), ne(0.0), emis(), absp(), scat() {}
+    np(-1.0), nmat(0), mat(), fp(), ne(0.0), mid(), mid_db(nullptr),
+    emis(), absp(), scat(),
+    mixed(false), mix_jmin(0), mix_jmax(0), mix_ite(0), mix_itr(0),
+    mix_ine(0), mix_em(), mix_ab(), mix_sc() {}
 
 //-----------------------------------------------------------------------------
 
 Zone::Zone(const size_t my_id_in): my_id(my_id_in), face(),
     te(-1.0), tr(-1.0),
-    np(-1.0), nmat(0), mat(), fp(), ne(0.0), emis(), absp(), scat() {}
+    np(-1.0), nmat(0), mat(), fp(), ne(0.0), mid(), mid_db(nullptr),
+    emis(), absp(), scat(),
+    mixed(false), mix_jmin(0), mix_jmax(0), mix_ite(0), mix_itr(0),
+    mix_ine(0), mix_em(), mix_ab(), mix_sc() {}
 
 //-----------------------------------------------------------------------------
 
 Zone::Zone(std::ifstream &geometry, std::ifstream &material):
     my_id(0), face(), te(-1.0), tr(-1.0),
-    np(-1.0), nmat(0), mat(), fp(), ne(0.0), emis(), absp(), scat()
+    np(-1.0), nmat(0), mat(), fp(), ne(0.0), mid(), mid_db(nullptr),
+    emis(), absp(), scat(),
+    mixed(false), mix_jmin(0), mix_jmax(0), mix_ite(0), mix_itr(0),
+    mix_ine(0), mix_em(), mix_ab(), mix_sc()
 {
     load_geo(geometry);
     load_mat(material);
@@ -60,9 +69,15 @@ void Zone::clear()
     mat.clear();
     fp.clear();
     ne = 0.0;
+    mid.clear();
+    mid_db = nullptr;
     emis.clear();
     absp.clear();
     scat.clear();
+    mixed = false;
+    mix_em.clear();
+    mix_ab.clear();
+    mix_sc.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -95,6 +110,13 @@ FacePtr Zone::get_face(const short int i) const
 
 //-----------------------------------------------------------------------------
 
+Face & Zone::face_at(const short int i) const
+{
+    return *face[static_cast<size_t>(i)];
+}
+
+//-----------------------------------------------------------------------------
+
 void Zone::set_ne(const double ne_in)
 {
     ne = ne_in;
@@ -112,6 +134,7 @@ double Zone::get_ne() const
 void Zone::set_te(const double te_in)
 {
     te = te_in;
+    mixed = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -126,6 +149,7 @@ double Zone::get_te() const
 void Zone::set_tr(const double tr_in)
 {
     tr = tr_in;
+    mixed = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -140,6 +164,7 @@ double Zone::get_tr() const
 void Zone::set_np(const double np_in)
 {
     np = np_in;
+    mixed = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -154,6 +179,8 @@ double Zone::get_np() const
 void Zone::set_nmat(const unsigned short int nmat_in)
 {
     nmat = nmat_in;
+    mid_db = nullptr;
+    mixed = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -168,6 +195,8 @@ unsigned short int Zone::get_nmat() const
 void Zone::set_mat(const std::vector<std::string> &mat_in)
 {
     mat = mat_in;
+    mid_db = nullptr;
+    mixed = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -189,6 +218,7 @@ const std::vector<std::string> & Zone::get_mat() const
 void Zone::set_fp(const std::vector<double> &fp_in)
 {
     fp = fp_in;
+    mixed = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -244,6 +274,10 @@ RetIntercept Zone::hit(const Grid &g, const Vector3d &p, const Vector3d &u,
 
     if (!rv.is_found)
     {   // try again, this time tracing from zp instead of p
+        #ifdef _OPENMP
+        #pragma omp atomic
+        #endif
+        ++nretries;
         Vector3d zp = zone_point(g, p);
         rv.t = Vector3d::get_big();
         for (size_t i = 0; i < n; ++i) // loop over *this Zone's Faces
@@ -258,6 +292,20 @@ RetIntercept Zone::hit(const Grid &g, const Vector3d &p, const Vector3d &u,
 
 //-----------------------------------------------------------------------------
 
+size_t Zone::get_nretries()
+{
+    return nretries;
+}
+
+//-----------------------------------------------------------------------------
+
+void Zone::reset_nretries()
+{
+    nretries = 0;
+}
+
+//-----------------------------------------------------------------------------
+
 std::string Zone::to_string() const
 {
     const size_t n = size();
@@ -307,6 +355,94 @@ void Zone::load_mat(std::ifstream &material)
         mat.emplace_back(std::move(s));
         fp.emplace_back(std::move(x));
     }
+    mid_db = nullptr;
+    mixed = false;
+}
+
+//-----------------------------------------------------------------------------
+
+void Zone::intern_mat(const Database &d, const Table &tbl)
+{
+    if (mid_db == &d  ||  nmat == 0) return;
+    mid = d.material_index(tbl, nmat, mat);
+    mid_db = &d;
+}
+
+//-----------------------------------------------------------------------------
+
+void Zone::mix_spectra(const Database &d, const Table &tbl,
+                       const size_t jmin, const size_t jmax)
+{
+    mixed = false;
+    if (nmat == 0) return;
+    intern_mat(d, tbl);
+    size_t ite(0), itr(0), ine(mix_ine); // seeds the find_ne bisection
+    ArrDbl em, ab, sc;
+    load_spectra(d, tbl, ite, itr, ine, "none", 0, false, jmin, jmax,
+                 em, ab, sc);
+    mix_jmin = jmin;
+    mix_jmax = jmax;
+    mix_ite = ite;
+    mix_itr = itr;
+    mix_ine = ine;
+    const size_t nhv = em.size();
+    mix_em.resize(nhv);
+    mix_ab.resize(nhv);
+    mix_sc.resize(nhv);
+    for (size_t j = 0; j < nhv; ++j) // stored as SpecReal (float, if SINGLE)
+    {
+        mix_em[j] = static_cast<SpecReal>(em[j]);
+        mix_ab[j] = static_cast<SpecReal>(ab[j]);
+        mix_sc[j] = static_cast<SpecReal>(sc[j]);
+    }
+    mixed = true;
+}
+
+//-----------------------------------------------------------------------------
+
+OpacityRequest Zone::opacity_request(const Table &tbl) const
+{
+    OpacityRequest r;
+    for (unsigned short int i = 0; i < nmat; ++i)
+        r.mat.push_back(tbl.get_F(mat.at(i)));
+    r.fp = fp;
+    r.te = te;
+    r.tr = tr;
+    r.np = np;
+    return r;
+}
+
+//-----------------------------------------------------------------------------
+
+void Zone::set_spectra(const OpacityReply &r,
+                       const size_t jmin, const size_t jmax)
+{
+    mixed = false;
+    if (nmat == 0) return;
+    mix_jmin = jmin;
+    mix_jmax = jmax;
+    mix_ite = 0; // no Database indices from an OpacityProvider
+    mix_itr = 0;
+    mix_ine = 0;
+    ne = r.ne;
+    const size_t nhv = r.em.size();
+    mix_em.resize(nhv);
+    mix_ab.resize(nhv);
+    mix_sc.resize(nhv);
+    for (size_t j = 0; j < nhv; ++j) // stored as SpecReal (float, if SINGLE)
+    {
+        mix_em[j] = static_cast<SpecReal>(r.em[j]);
+        mix_ab[j] = static_cast<SpecReal>(r.ab[j]);
+        mix_sc[j] = static_cast<SpecReal>(r.sc[j]);
+    }
+    mixed = true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Zone::is_mixed() const
+{
+    return mixed;
 }
 
 //-----------------------------------------------------------------------------
@@ -318,13 +454,25 @@ void Zone::load_spectra(const Database &d, const Table &tbl,
                         const size_t jmin, const size_t jmax,
                         ArrDbl &em, ArrDbl &ab, ArrDbl &sc) // not const
 {
-    size_t nhv_max = d.get_nhv();
     size_t nhv = jmax - jmin + 1;
     em.assign(nhv, 0.0);
     ab.assign(nhv, 0.0);
     sc.assign(nhv, 0.0);
 
-    if (nmat > 0)
+    if (nmat > 0  &&  mixed  &&  mix_jmin <= jmin  &&  jmax <= mix_jmax)
+    {   // precomputed by mix_spectra(), shared by all Rays and Detectors
+        ite = mix_ite;
+        itr = mix_itr;
+        ine = mix_ine;
+        const size_t k = jmin - mix_jmin;
+        for (size_t j = 0; j < nhv; ++j)
+        {
+            em[j] = mix_em[k+j];
+            ab[j] = mix_ab[k+j];
+            sc[j] = mix_sc[k+j];
+        }
+    }
+    else if (nmat > 0)
     {
         /* NOTE:
          In analysis mode with spherical symmetry we are "peeling the onion";
@@ -337,35 +485,49 @@ void Zone::load_spectra(const Database &d, const Table &tbl,
         if ((symmetry == "none") || analysis ||
             ((symmetry != "none") && (ix == 0))) // ix == 0 == central Ray
         {
-            ArrDbl v; // working array used by each material and quantity
-            v.assign(nhv, 0.0); // actually allocate nhv elements
-
-            NeData ne_data(d.find_ne(tbl,te,ite,tr,itr,np,nmat,mat,fp,ine));
-            ne = ne_data.first;
-            std::string froot, fname;
-            double fpop;
-            const std::string dirpath(d.get_path() + "spectra/");
-            for (unsigned short int i = 0; i < nmat; ++i)
+            // working arrays used by each material
+            ArrDbl vem(nhv), vab(nhv), vsc(nhv);
+
+            // integer material indices, if intern_mat() was called for d
+            const bool ids = (mid_db == &d);
+            if (ids)
+                ne = d.find_ne(te, ite, tr, itr, np, nmat, mid, fp, ine);
+            else
+                ne = d.find_ne(tbl,te,ite,tr,itr,np,nmat,mat,fp,ine).first;
+            // states that snap to the same grid point mix only once
+            MixKey key;
+            if (ids)
             {
-                std::string m(tbl.get_F(mat.at(i)));
-                froot = dirpath + m + "/" + m + ne_data.second;
-                fpop = fp.at(i);
-
-                fname = froot + "em.txt";
-                utils::load_array(fname, nhv_max, jmin, jmax, v);
-                em  +=  fpop * v;
-
-                fname = froot + "ab.txt";
-                utils::load_array(fname, nhv_max, jmin, jmax, v);
-                ab  +=  fpop * v;
-
-                fname = froot + "sc.txt";
-                utils::load_array(fname, nhv_max, jmin, jmax, v);
-                sc  +=  fpop * v;
+                key.mid = mid;
+                key.fp = fp;
+                key.np = np;
+                key.ite = ite;
+                key.itr = itr;
+                key.ine = ine;
+                key.jmin = jmin;
+                key.jmax = jmax;
+            }
+            if (!ids  ||  !d.get_mixture(key, em, ab, sc))
+            {
+                double fpop;
+                for (unsigned short int i = 0; i < nmat; ++i)
+                {   // spectra come from the Database's in-memory cache
+                    if (ids)
+                        d.get_spectra(mid[i], ite, itr, ine,
+                                      jmin, jmax, vem, vab, vsc);
+                    else
+                        d.get_spectra(tbl.get_F(mat.at(i)), ite, itr, ine,
+                                      jmin, jmax, vem, vab, vsc);
+                    fpop = fp.at(i);
+                    em  +=  fpop * vem;
+                    ab  +=  fpop * vab;
+                    sc  +=  fpop * vsc;
+                }
+                em *= np;
+                ab *= np;
+                sc *= np;
+                if (ids) d.put_mixture(key, em, ab, sc);
             }
-            em *= np;
-            ab *= np;
-            sc *= np;
 
             if (symmetry != "none") // in 1-D, save spectral data from ix == 0
             {   // Ray for reuse by other Rays within the same time interval
@@ -387,6 +549,39 @@ void Zone::load_spectra(const Database &d, const Table &tbl,
 
 //-----------------------------------------------------------------------------
 
+void Zone::load_bands(const Database &d, const Table &tbl,
+                      size_t &ite, size_t &itr, size_t &ine,
+                      const size_t ib, const size_t nb,
+                      ArrDbl &em, ArrDbl &ab, ArrDbl &sc) // not const
+{
+    em.assign(nb, 0.0);
+    ab.assign(nb, 0.0);
+    sc.assign(nb, 0.0);
+    if (nmat == 0) return;
+
+    ArrDbl vem(nb), vab(nb), vsc(nb);
+    const bool ids = (mid_db == &d);
+    if (ids)
+        ne = d.find_ne(te, ite, tr, itr, np, nmat, mid, fp, ine);
+    else
+        ne = d.find_ne(tbl,te,ite,tr,itr,np,nmat,mat,fp,ine).first;
+    double fpop;
+    for (unsigned short int i = 0; i < nmat; ++i)
+    {
+        size_t imat = ids ? mid[i] : d.material_index(tbl.get_F(mat.at(i)));
+        d.get_bands(imat, ite, itr, ine, ib, vem, vab, vsc);
+        fpop = fp.at(i);
+        em  +=  fpop * vem;
+        ab  +=  fpop * vab;
+        sc  +=  fpop * vsc;
+    }
+    em *= np;
+    ab *= np;
+    sc *= np;
+}
+
+//-----------------------------------------------------------------------------
+
 std::string Zone::mat_to_string_full() const
 {
     std::string s("Zone");
@@ -430,6 +625,8 @@ std::ostream & operator << (std::ostream &ost, const Zone &o)
 
 const size_t Zone::BOUNDING_ZONE = Face::BOUNDING_SPHERE.my_zone;
 
+size_t Zone::nretries = 0;
+
 //-----------------------------------------------------------------------------
 
 //  end Zone.cpp
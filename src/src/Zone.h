@@ -7,7 +7,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 8 December 2014\n
- * Last modified on 6 October 2020
+ * Last modified on 16 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -17,6 +17,7 @@
 #include <ArrDbl.h>
 #include <Database.h>
 #include <Face.h>
+#include <OpacityProvider.h>
 
 #include <memory>
 
@@ -79,6 +80,14 @@ public:
      */
     FacePtr get_face(const short int i) const;
 
+    /**
+     * @brief Non-owning access to the i-th Face within *this Zone
+     *        (Zone::face), for Ray traversal
+     * @param[in] i Face index (not range-checked)
+     * @return Reference to the Face
+     */
+    Face & face_at(const short int i) const;
+
     /**
      * @brief Setter for the electron number density (Zone::ne)
      * @param[in] ne_in Electron number density (electrons/cm3)
@@ -202,6 +211,16 @@ public:
     RetIntercept hit(const Grid &g, const Vector3d &p, const Vector3d &u,
                      const FaceID &fid) const;
 
+    /**
+     * @brief Getter for the number of hit() calls that had to retry from
+     *        zone_point(), since the start or the last reset_nretries()
+     * @return Number of retries, in all Zones and threads
+     */
+    static size_t get_nretries();
+
+    /// Sets the number of hit() retries to zero
+    static void reset_nretries();
+
     /**
      * @brief String representation of a Zone object
      * @return String representation of *this
@@ -225,8 +244,57 @@ public:
      */
     void load_mat(std::ifstream &material);
 
+    /**
+     * @brief Resolves the materials of *this Zone into Database material
+     *        indices once per material state, so that load_spectra() does
+     *        no string work; call from a single thread (not within a Ray
+     *        bundle), since Rays share Zones
+     * @param[in] d Database
+     * @param[in] tbl Table of materials
+     */
+    void intern_mat(const Database &d, const Table &tbl);
+
+    /**
+     * @brief Precomputes mixed monochromatic optical data for *this Zone,
+     *        to be shared by all Rays and Detectors until the material
+     *        state of *this Zone changes
+     * @param[in] d Database
+     * @param[in] tbl Table of materials
+     * @param[in] jmin Lower index of the photon energy grid covering all
+     *            Detectors
+     * @param[in] jmax Upper index of the photon energy grid covering all
+     *            Detectors
+     */
+    void mix_spectra(const Database &d, const Table &tbl,
+                     const size_t jmin, const size_t jmax);
+
+    /**
+     * @brief Material state of *this Zone, for an OpacityProvider
+     * @param[in] tbl Table of materials
+     * @return Material file handles, fractions, te, tr, np
+     */
+    OpacityRequest opacity_request(const Table &tbl) const;
+
+    /**
+     * @brief Stores mixed optical data obtained from an OpacityProvider,
+     *        used as if computed by mix_spectra()
+     * @param[in] r Reply to opacity_request()
+     * @param[in] jmin Lower index of the photon energy grid of r
+     * @param[in] jmax Upper index of the photon energy grid of r
+     */
+    void set_spectra(const OpacityReply &r,
+                     const size_t jmin, const size_t jmax);
+
+    /**
+     * @brief Flags whether mix_spectra() (or set_spectra()) data are
+     *        available
+     * @return true, if Zone::mix_em, Zone::mix_ab, Zone::mix_sc are current
+     */
+    bool is_mixed() const;
+
     /**
      * @brief Builds mixed monochromatic optical data for *this Zone;
+     *        \n if mix_spectra() data cover [jmin, jmax], those are sliced;
      *        \n if symmetry != "none", also either stores newly computed data
      *        \n (Zone::emis, Zone::absp, Zone::scat) or retrieves them.
      *        \n Assumes Zone::load_mat (material) has already been called
@@ -251,6 +319,27 @@ public:
                       const size_t jmin, const size_t jmax,
                       ArrDbl &em, ArrDbl &ab, ArrDbl &sc); // not const
 
+    /**
+     * @brief Builds mixed band-averaged optical data for *this Zone from
+     *        Database::get_bands, i.e., averaged once per Database grid point
+     *        and mixed as in load_spectra() (the Rosseland mean of a mixture
+     *        is thus approximated by the mixture of Rosseland means)
+     * @param[in] d Database
+     * @param[in] tbl Table of materials
+     * @param[in,out] ite Electron temperature integer index from Database
+     * @param[in,out] itr Radiation temperature integer index from Database
+     * @param[in,out] ine Electron density integer index from Database
+     * @param[in] ib BandSet index (see Database::band_index)
+     * @param[in] nb Number of bands
+     * @param[in,out] em Band-averaged emissivity ( W / cm3 / sr / eV )
+     * @param[in,out] ab Band-averaged absorption ( 1 / cm )
+     * @param[in,out] sc Band-averaged scattering ( 1 / cm )
+     */
+    void load_bands(const Database &d, const Table &tbl,
+                    size_t &ite, size_t &itr, size_t &ine,
+                    const size_t ib, const size_t nb,
+                    ArrDbl &em, ArrDbl &ab, ArrDbl &sc); // not const
+
     /**
      * @brief Full string representation of materials in *this Zone
      * @return Material info in the FESTR hydro input format (ASCII)
@@ -265,6 +354,9 @@ public:
 
 
 private:
+    /// Number of hit() calls that retried from zone_point()
+    static size_t nretries;
+
     // Geometry (read from "mesh_*" files)
 
     /// Unique ID of *this Zone on the Mesh
@@ -297,6 +389,12 @@ private:
     /// Electron number density (el./cm3) from charge neutrality constraint
     double ne;
 
+    /// Database material indices of Zone::mat, set by intern_mat()
+    std::vector<size_t> mid;
+
+    /// Database that Zone::mid refers to; nullptr, if not current
+    const Database *mid_db;
+
     // Arrays only to be used in 1-D geometry to speed up the calculation
     // by computing optical data once, and then saving/retrieving them
 
@@ -308,6 +406,36 @@ private:
 
     /// Monochromatic scattering coefficient ( 1 / cm )
     ArrDbl scat;
+
+    // Optical data precomputed once per material state by mix_spectra(),
+    // reset by every setter of the material state
+
+    /// Flags whether the mix_* members are current
+    bool mixed;
+
+    /// Lower index of the photon energy grid of the mix_* arrays
+    size_t mix_jmin;
+
+    /// Upper index of the photon energy grid of the mix_* arrays
+    size_t mix_jmax;
+
+    /// Electron temperature Database index found by mix_spectra()
+    size_t mix_ite;
+
+    /// Radiation temperature Database index found by mix_spectra()
+    size_t mix_itr;
+
+    /// Electron density Database index found by mix_spectra()
+    size_t mix_ine;
+
+    /// Mixed monochromatic emissivity ( W / cm3 / sr / eV )
+    std::vector<SpecReal> mix_em;
+
+    /// Mixed monochromatic absorption coefficient ( 1 / cm )
+    std::vector<SpecReal> mix_ab;
+
+    /// Mixed monochromatic scattering coefficient ( 1 / cm )
+    std::vector<SpecReal> mix_sc;
 };
 
 //-----------------------------------------------------------------------------
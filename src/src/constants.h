@@ -6,7 +6,7 @@
  * @brief List of fundamental and other constants
  * @author Peter Hakel
  * @date Created on 20 November 2014\n
- * Last modified on 8 October 2020
+ * Last modified on 16 October 2026
  * @version 0.9
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
@@ -63,6 +63,12 @@ const std::string DASHES = "---------------------------------------------";
 /// Zone separator
 const std::string ZONE_SEPARATOR = "\n" + DASHES + "\n";
 
+/// Name of the packed Database file within a Database directory
+const std::string DBPACK_FNAME = "dbase.fdb";
+
+/// Name of the catalog index file within a text Database directory
+const std::string CATALOG_FNAME = "catalog.txt";
+
 } // namespace cnststr
 
 #endif  // LANL_ASC_PEM_CONSTANTS_H_
@@ -4,7 +4,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 20 November 2014\n
- * Last modified on 26 November 2020
+ * Last modified on 17 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -25,6 +25,12 @@
 #include <sstream>
 #include <stdexcept>
 
+#include <dirent.h>
+#include <sys/stat.h>
+#ifdef WIN
+#include <direct.h>
+#endif
+
 //-----------------------------------------------------------------------------
 
 double utils::radians(const double x)
@@ -116,6 +122,26 @@ std::string utils::file_to_string(const std::string &fname)
 
 //-----------------------------------------------------------------------------
 
+uint64_t utils::hash_string(const std::string &s, uint64_t h)
+{
+    return hash_bytes(s.data(), s.size(), h);
+}
+
+//-----------------------------------------------------------------------------
+
+uint64_t utils::hash_bytes(const void *p, const size_t n, uint64_t h)
+{
+    const unsigned char *c = static_cast<const unsigned char *>(p);
+    for (size_t i = 0; i < n; ++i)
+    {
+        h ^= c[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+//-----------------------------------------------------------------------------
+
 int utils::sign_int(const int x)
 {
     if (x > 0)
@@ -225,6 +251,55 @@ void utils::find_word(std::ifstream &istr, const std::string &str)
 
 //-----------------------------------------------------------------------------
 
+bool utils::find_word_opt(std::ifstream &istr, const std::string &str)
+{
+    std::streampos pos = istr.tellg();
+    std::string s;
+    while (istr >> s)
+        if (trim(s) == str) return true;
+    istr.clear();
+    istr.seekg(pos);
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+
+std::vector<std::string> utils::list_dir(const std::string &path,
+                                         const bool dirs)
+{
+    std::vector<std::string> v;
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr) return v;
+    struct dirent *e;
+    while ((e = readdir(dir)) != nullptr)
+    {
+        std::string s(e->d_name);
+        if (s == "."  ||  s == "..") continue;
+        struct stat st;
+        if (stat((path + s).c_str(), &st) != 0) continue;
+        if (dirs ? S_ISDIR(st.st_mode) : S_ISREG(st.st_mode))
+            v.emplace_back(std::move(s));
+    }
+    closedir(dir);
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+//-----------------------------------------------------------------------------
+
+bool utils::make_dir(const std::string &path)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0) return S_ISDIR(st.st_mode);
+    #ifdef WIN
+    return _mkdir(path.c_str()) == 0;
+    #else
+    return mkdir(path.c_str(), 0755) == 0;
+    #endif
+}
+
+//-----------------------------------------------------------------------------
+
 std::string utils::fname_root(const std::string &material,
                               const std::string &te_str,
                               const std::string &tr_str,
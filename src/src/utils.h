@@ -7,7 +7,7 @@
  * @author Peter Hakel
  * @version 0.9
  * @date Created on 20 November 2014\n
- * Last modified on 26 February 2020
+ * Last modified on 17 October 2026
  * @copyright (c) 2015, Triad National Security, LLC.
  * All rights reserved.\n
  * Use of this source code is governed by the BSD 3-Clause License.
@@ -17,9 +17,12 @@
 #include <constants.h>
 
 #include <cmath>
+#include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
+#include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -125,6 +128,29 @@ static std::string file_to_string(const std::string &fname);
 
 //-----------------------------------------------------------------------------
 
+/**
+  * @brief Content hash of a string (64-bit FNV-1a)
+  * @param[in] s String, e.g., from file_to_string
+  * @param[in] h Hash to continue from (to combine several strings)
+  * @return Hash value
+  */
+static uint64_t hash_string(const std::string &s,
+                            uint64_t h = 14695981039346656037ULL);
+
+//-----------------------------------------------------------------------------
+
+/**
+  * @brief Content hash of a memory block (64-bit FNV-1a, as hash_string)
+  * @param[in] p Start of the block, e.g., std::vector::data()
+  * @param[in] n Size of the block in bytes
+  * @param[in] h Hash to continue from (to combine several blocks)
+  * @return Hash value
+  */
+static uint64_t hash_bytes(const void *p, const size_t n,
+                           uint64_t h = 14695981039346656037ULL);
+
+//-----------------------------------------------------------------------------
+
 /**
   * @brief Sign flag
   * @param[in] x Real number
@@ -210,6 +236,40 @@ static void find_word(std::ifstream &istr, const std::string &str);
 
 //-----------------------------------------------------------------------------
 
+/**
+  * @brief Searches forward in a text file to locate an optional word
+  *
+  * Like find_word(), but if str is not found the stream pointer is
+  * restored to where it was on entry, and the program continues
+  *
+  * @param[in,out] istr File stream
+  * @param[in] str Word to be found
+  * @return true, if str was found; false, otherwise
+ */
+static bool find_word_opt(std::ifstream &istr, const std::string &str);
+
+//-----------------------------------------------------------------------------
+
+/**
+  * @brief Lists the contents of a directory
+  * @param[in] path Directory path (including the trailing "/")
+  * @param[in] dirs Lists subdirectories if true, regular files if false
+  * @return Sorted names of entries; empty, if path cannot be opened
+ */
+static std::vector<std::string> list_dir(const std::string &path,
+                                         const bool dirs);
+
+//-----------------------------------------------------------------------------
+
+/**
+  * @brief Creates a directory, unless it already exists
+  * @param[in] path Directory path
+  * @return true, if the directory exists on return; false, otherwise
+ */
+static bool make_dir(const std::string &path);
+
+//-----------------------------------------------------------------------------
+
 /**
   * @brief Locates a value in an ordered table by bisecting bracketing interval
   * @param[in] x Value to be located in table v
@@ -381,6 +441,12 @@ static void load_array(const std::string &fname, const size_t n,
                        const size_t jmin, const size_t jmax, T &v)
 {
     std::ifstream infile(fname.c_str());
+    if (!infile.is_open())
+    {
+        std::cerr << "Error: file " << fname << " is not open "
+                  << "in utils::load_array" << std::endl;
+        exit(EXIT_FAILURE);
+    }
     find_word(infile, "data");
     std::string s;
     getline(infile, s);